@@ -0,0 +1,13 @@
+#version 460 core
+
+//Draws one cached board chunk; paired with res/shaders/overview/vertex.shader
+layout(location = 0) in vec2 TexCoord;
+
+layout(location = 0) out vec4 FragColor;
+
+layout(binding = 0) uniform sampler2D chunk;
+
+void main()
+{
+	FragColor = texture(chunk, TexCoord);
+}
@@ -0,0 +1,24 @@
+#version 460 core
+
+layout(location = 0) in vec2 TexCoord;
+
+layout(location = 0) out vec4 FragColor;
+
+//r = revealed fraction, g = flag density, b = exploded mines, averaged over however many
+//cells the mip level the sampler picks covers per texel
+layout(binding = 0) uniform sampler2D overview;
+
+const vec3 HIDDEN_COLOR = vec3(0.55, 0.32, 0.26);
+const vec3 REVEALED_COLOR = vec3(0.75, 0.75, 0.72);
+const vec3 FLAG_COLOR = vec3(0.9, 0.15, 0.1);
+const vec3 MINE_COLOR = vec3(0.05, 0.05, 0.05);
+
+void main()
+{
+	vec3 cells = texture(overview, TexCoord).rgb;
+	vec3 color = mix(HIDDEN_COLOR, REVEALED_COLOR, cells.r);
+	color = mix(color, FLAG_COLOR, cells.g);
+	//A single hit mine must still show up from far away, so it is boosted
+	color = mix(color, MINE_COLOR, clamp(cells.b * 16.0, 0.0, 1.0));
+	FragColor = vec4(color, 1.0);
+}
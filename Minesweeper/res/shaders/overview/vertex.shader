@@ -0,0 +1,17 @@
+#version 460 core
+
+//Board overview: one quad over the visible part of the board, used once a cell is smaller than a pixel.
+//Also places the cached chunk quads of BoardCache.
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 aTexCoord;
+
+layout(location = 0) out vec2 TexCoord;
+
+//Cells relative to the camera's origin cell to clip space, from Camera::ViewProjection
+layout(location = 0) uniform mat4 viewProjection;
+
+void main()
+{
+	gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+	TexCoord = aTexCoord;
+}
@@ -0,0 +1,14 @@
+#version 460 core
+
+layout(location = 0) in vec2 TexCoord;
+layout(location = 1) in vec4 colorToUse;
+
+layout(location = 0) out vec4 FragColor;
+
+//Untextured sprites get SpriteBatch's 1x1 white texture, so they come out as their color
+layout(binding = 0) uniform sampler2D sprite;
+
+void main()
+{
+	FragColor = texture(sprite, TexCoord) * colorToUse;
+}
@@ -0,0 +1,19 @@
+#version 460 core
+
+//SpriteBatch quads, already in screen pixels
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 colorInput;
+
+layout(location = 0) out vec2 TexCoord;
+layout(location = 1) out vec4 colorToUse;
+
+//Pixels to clip space
+layout(location = 0) uniform mat4 projection;
+
+void main()
+{
+	gl_Position = projection * vec4(position, 0.0, 1.0);
+	TexCoord = aTexCoord;
+	colorToUse = colorInput;
+}
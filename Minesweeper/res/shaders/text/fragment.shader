@@ -0,0 +1,20 @@
+#version 460 core
+
+//Signed distance field text from TextRenderer; paired with res/shaders/sprite/vertex.shader
+layout(location = 0) in vec2 TexCoord;
+layout(location = 1) in vec4 colorToUse;
+
+layout(location = 0) out vec4 FragColor;
+
+//FontAtlas: 0.5 on the outline, rising inside
+layout(binding = 0) uniform sampler2D atlas;
+
+void main()
+{
+	float distance = texture(atlas, TexCoord).r;
+	//About one pixel of antialiasing at any size
+	//(never zero, smoothstep is undefined for equal edges, e.g. on the solid glyph)
+	float width = max(fwidth(distance) * 0.7, 1e-4);
+	float coverage = smoothstep(0.5 - width, 0.5 + width, distance);
+	FragColor = vec4(colorToUse.rgb, colorToUse.a * coverage);
+}
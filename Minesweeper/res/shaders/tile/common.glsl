@@ -0,0 +1,52 @@
+//Shared by the tile vertex and fragment shaders
+
+//Feature switches. The GLSL path gets them as #defines from TileShader::Defines, the SPIR-V path
+//as specialization constants from TileShader::Specialization. Either way they are compile time
+//constants, so every branch on them is folded away in the final program.
+#ifdef GL_SPIRV
+layout(constant_id = 0) const bool FEATURE_TEXTURED = false;
+layout(constant_id = 1) const bool FEATURE_ANIMATED = false;
+layout(constant_id = 2) const bool FEATURE_HOVER_HIGHLIGHT = false;
+layout(constant_id = 3) const float TILE_SCALE = 1.0;
+#else
+#ifdef TEXTURED
+const bool FEATURE_TEXTURED = true;
+#else
+const bool FEATURE_TEXTURED = false;
+#endif
+#ifdef ANIMATED
+const bool FEATURE_ANIMATED = true;
+#else
+const bool FEATURE_ANIMATED = false;
+#endif
+#ifdef HOVER_HIGHLIGHT
+const bool FEATURE_HOVER_HIGHLIGHT = true;
+#else
+const bool FEATURE_HOVER_HIGHLIGHT = false;
+#endif
+#ifndef TILE_SCALE
+#define TILE_SCALE 1.0
+#endif
+#endif
+
+const float HOVER_HIGHLIGHT_AMOUNT = 0.25;
+const float ANIMATION_PULSE_SPEED = 6.2831853;
+const float ANIMATION_PULSE_SCALE = 0.05;
+
+//Reveal ripple: each cell starts REVEAL_RIPPLE_DELAY seconds per flood fill step after the
+//clicked one and takes REVEAL_DURATION to open
+const float REVEAL_RIPPLE_DELAY = 0.015;
+const float REVEAL_DURATION = 0.2;
+const float REVEAL_SHRINK = 0.3;
+const vec3 REVEALED_COLOR = vec3(0.75, 0.75, 0.72);
+
+//Faces from CellReveal::Face; anything lower is the number of an open safe cell
+const int FACE_MINE = 13;
+const int FACE_FLAG = 14;
+//Glyph box of a triangle relative to a square's, so it stays inside the triangle
+const float GLYPH_TRIANGLE_SIZE = 0.55;
+
+vec3 Highlight(vec3 color)
+{
+	return mix(color, vec3(1.0), HOVER_HIGHLIGHT_AMOUNT);
+}
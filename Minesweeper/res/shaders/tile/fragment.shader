@@ -0,0 +1,112 @@
+#version 460 core
+#ifdef GL_SPIRV
+#extension GL_GOOGLE_include_directive : require
+#endif
+#include "common.glsl"
+
+//Variants: TEXTURED samples ourTexture, otherwise the vertex color is used.
+//HOVER_HIGHLIGHT brightens the tile. Revealed cells blend to REVEALED_COLOR and show their
+//number or mine; hidden ones show their flag. Glyphs are drawn from distances, so they stay
+//sharp at any zoom without a texture.
+layout(location = 0) in vec3 colorToUse;
+layout(location = 1) in vec2 TexCoord;
+layout(location = 2) in float revealed;
+layout(location = 3) flat in int face;
+layout(location = 4) in vec2 glyphPosition;
+
+layout(location = 0) out vec4 FragColor;
+
+//SPIR-V programs can not look uniforms up by name, so the sampler unit is fixed here
+layout(binding = 0) uniform sampler2D ourTexture;
+
+//Classic colors of 1 to 8; larger numbers, only on triangle grids, are black
+const vec3 NUMBER_COLORS[9] = vec3[9](
+	vec3(0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.5, 0.0), vec3(1.0, 0.0, 0.0), vec3(0.0, 0.0, 0.5),
+	vec3(0.5, 0.0, 0.0), vec3(0.0, 0.5, 0.5), vec3(0.0), vec3(0.5));
+//Bits a to g of each seven segment digit: top, top right, bottom right, bottom, bottom left, top left, middle
+const int DIGIT_SEGMENTS[10] = int[10](0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F);
+//Half the width of a segment
+const float DIGIT_STROKE = 0.05;
+const vec3 MINE_COLOR = vec3(0.05);
+const vec3 EXPLODED_COLOR = vec3(0.9, 0.1, 0.1);
+const vec3 FLAG_COLOR = vec3(0.9, 0.05, 0.05);
+const vec3 POLE_COLOR = vec3(0.1);
+
+float DistanceToSegment(vec2 p, vec2 a, vec2 b)
+{
+	vec2 ab = b - a;
+	return length(p - a - ab * clamp(dot(p - a, ab) / dot(ab, ab), 0.0, 1.0));
+}
+
+//Antialiased coverage of everything closer than radius, from a distance in glyph units
+float Coverage(float distance, float radius)
+{
+	float width = max(fwidth(distance), 1e-4);
+	return 1.0 - smoothstep(radius - width, radius + width, distance);
+}
+
+//Signed distance to the outline of a digit 0.3 wide and 0.5 tall around center, times size
+float DigitDistance(vec2 p, vec2 center, float size, int digit)
+{
+	int segments = DIGIT_SEGMENTS[digit];
+	vec2 q = (p - center) / size;
+	const vec2 TOP_LEFT = vec2(-0.15, -0.25), TOP_RIGHT = vec2(0.15, -0.25);
+	const vec2 MIDDLE_LEFT = vec2(-0.15, 0.0), MIDDLE_RIGHT = vec2(0.15, 0.0);
+	const vec2 BOTTOM_LEFT = vec2(-0.15, 0.25), BOTTOM_RIGHT = vec2(0.15, 0.25);
+	float distance = 1e3;
+	if ((segments & 0x01) != 0) distance = min(distance, DistanceToSegment(q, TOP_LEFT, TOP_RIGHT));
+	if ((segments & 0x02) != 0) distance = min(distance, DistanceToSegment(q, TOP_RIGHT, MIDDLE_RIGHT));
+	if ((segments & 0x04) != 0) distance = min(distance, DistanceToSegment(q, MIDDLE_RIGHT, BOTTOM_RIGHT));
+	if ((segments & 0x08) != 0) distance = min(distance, DistanceToSegment(q, BOTTOM_LEFT, BOTTOM_RIGHT));
+	if ((segments & 0x10) != 0) distance = min(distance, DistanceToSegment(q, MIDDLE_LEFT, BOTTOM_LEFT));
+	if ((segments & 0x20) != 0) distance = min(distance, DistanceToSegment(q, TOP_LEFT, MIDDLE_LEFT));
+	if ((segments & 0x40) != 0) distance = min(distance, DistanceToSegment(q, MIDDLE_LEFT, MIDDLE_RIGHT));
+	return (distance - DIGIT_STROKE) * size;
+}
+
+//Pole standing on a base
+float PoleCoverage(vec2 p)
+{
+	float pole = Coverage(DistanceToSegment(p, vec2(0.08, -0.3), vec2(0.08, 0.3)), 0.035);
+	float base = Coverage(DistanceToSegment(p, vec2(-0.12, 0.3), vec2(0.2, 0.3)), 0.035);
+	return max(pole, base);
+}
+
+//Triangle (0.08, -0.3), (0.08, 0.02), (-0.25, -0.14) hanging left of the pole
+float PennantCoverage(vec2 p)
+{
+	float slope = (0.08 - p.x) * 0.485;
+	return Coverage(max(p.x - 0.08, max(-0.3 + slope - p.y, p.y - 0.02 + slope)), 0.0);
+}
+
+void main()
+{
+	if (FEATURE_TEXTURED)
+		FragColor = texture(ourTexture, TexCoord);
+	else
+		FragColor = vec4(colorToUse, 1.0f);
+
+	//The revealed face fades in over the hidden one
+	vec3 revealedColor = REVEALED_COLOR;
+	if (face == FACE_MINE)
+	{
+		revealedColor = mix(EXPLODED_COLOR, MINE_COLOR, Coverage(length(glyphPosition), 0.22));
+	}
+	else if (face > 0 && face < FACE_MINE)
+	{
+		vec3 color = NUMBER_COLORS[face < 9 ? face : 0];
+		//Two digits side by side at 0.7 the size
+		float distance = face < 10 ? DigitDistance(glyphPosition, vec2(0.0), 1.0, face)
+		                           : min(DigitDistance(glyphPosition, vec2(-0.15, 0.0), 0.7, 1), DigitDistance(glyphPosition, vec2(0.15, 0.0), 0.7, face - 10));
+		revealedColor = mix(revealedColor, color, Coverage(distance, 0.0));
+	}
+	else if (face == FACE_FLAG)
+	{
+		FragColor.rgb = mix(FragColor.rgb, POLE_COLOR, PoleCoverage(glyphPosition));
+		FragColor.rgb = mix(FragColor.rgb, FLAG_COLOR, PennantCoverage(glyphPosition));
+	}
+	FragColor.rgb = mix(FragColor.rgb, revealedColor, revealed);
+
+	if (FEATURE_HOVER_HIGHLIGHT)
+		FragColor.rgb = Highlight(FragColor.rgb);
+}
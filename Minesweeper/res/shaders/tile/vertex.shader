@@ -0,0 +1,79 @@
+#version 460 core
+#ifdef GL_SPIRV
+#extension GL_GOOGLE_include_directive : require
+#endif
+#include "common.glsl"
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec3 colorInput;
+layout(location = 2) in vec2 aTexCoord;
+//Per instance: x = game time the cell was revealed (negative while hidden), y = flood fill distance from the click,
+//z = what the cell shows, a number or a CellReveal::Face
+layout(location = 3) in vec3 reveal;
+
+
+layout(location = 0) out vec3 colorToUse;
+layout(location = 1) out vec2 TexCoord;
+//0 while hidden, 1 once fully revealed
+layout(location = 2) out float revealed;
+layout(location = 3) flat out int face;
+//Position in the cell's glyph box, [-0.5, 0.5] around the middle of the tile, y down
+layout(location = 4) out vec2 glyphPosition;
+
+layout(location = 0) uniform float time;
+//Columns and rows; cell i is (i % columns, i / columns)
+layout(location = 1) uniform ivec2 boardSize;
+//Cell near the camera that positions are taken relative to, so they stay small enough for float
+layout(location = 2) uniform ivec2 cellOrigin;
+//Positions relative to the integer world origin near the camera to clip space, from Camera::ViewProjection
+layout(location = 3) uniform mat4 viewProjection;
+//Cell of gl_InstanceID 0, for draws of a range of rows
+layout(location = 4) uniform int firstCell;
+//Topology layout from GridTopology::Layout: column step, row step, odd row shift, half the cell height
+layout(location = 5) uniform vec4 cellLayout;
+//Nonzero to mirror every other cell vertically, for triangles
+layout(location = 6) uniform int alternate;
+//Where cellOrigin is relative to the world origin, worked out in double on the CPU; about a cell while the board is in view
+layout(location = 7) uniform vec2 cellOffset;
+
+
+void main()
+{
+	float progress = 0.0;
+	if (reveal.x >= 0.0)
+		progress = clamp((time - reveal.x - reveal.y * REVEAL_RIPPLE_DELAY) / REVEAL_DURATION, 0.0, 1.0);
+
+	float scale = TILE_SCALE;
+	if (FEATURE_ANIMATED)
+	{
+		if (progress == 0.0)
+			scale *= 1.0 + ANIMATION_PULSE_SCALE * sin(time * ANIMATION_PULSE_SPEED);
+		else
+			scale *= 1.0 - REVEAL_SHRINK * sin(progress * 3.14159265);
+	}
+
+	int index = firstCell + gl_InstanceID;
+	ivec2 cell = ivec2(index % boardSize.x, index / boardSize.x);
+	//cell * step - world origin, with only small numbers reaching float
+	vec2 center = vec2(cell - cellOrigin) * cellLayout.xy + cellOffset;
+	center += vec2(0.5 + cellLayout.z * float(cell.y & 1), cellLayout.w);
+	vec2 corner = position.xy;
+	bool mirrored = alternate != 0 && ((cell.x + cell.y) & 1) != 0;
+	if (mirrored)
+		corner.y = -corner.y;
+	//Triangles keep their glyph inside the incircle, a third of the way down from the middle
+	vec2 glyphCenter = vec2(0.0);
+	float glyphSize = 1.0;
+	if (alternate != 0)
+	{
+		glyphCenter.y = (mirrored ? -cellLayout.w : cellLayout.w) / 3.0;
+		glyphSize = GLYPH_TRIANGLE_SIZE;
+	}
+
+	gl_Position = viewProjection * vec4(center + corner * scale, 0.0, 1.0);
+	revealed = progress;
+	face = int(reveal.z);
+	glyphPosition = (corner - glyphCenter) / glyphSize;
+	colorToUse = colorInput;
+	TexCoord = aTexCoord;
+}
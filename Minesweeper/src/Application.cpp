@@ -1,28 +1,166 @@
 //STD LIBRARY
-#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
 #include <iostream>
-#include <sstream>
-#include <Debug.h>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
 //OPENGL STUFF
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
 
 //MY INCLUDES
-#include "IndexBufferObject.h"
-#include "ShaderProgram.h"
-#include "VertexArrayObject.h"
-#include "VertexBufferObject.h"
-#include <stb_image/stb_image.h>
+#include "Board.h"
+#include "BoardHistory.h"
+#include "CellReveal.h"
+#include "EndlessField.h"
+#include "GameClock.h"
+#include "GameSnapshot.h"
+#include "HintCache.h"
+#include "Hud.h"
+#include "InputEvent.h"
+#include "RenderCommand.h"
+#include "RenderThread.h"
+#include "ReplayLog.h"
+#include "Stopwatch.h"
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-void processInput(GLFWwindow* window);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+void cursor_position_callback(GLFWwindow* window, double x, double y);
+void scroll_callback(GLFWwindow* window, double x, double y);
+glm::dvec2 windowToFramebuffer(GLFWwindow* window, double x, double y);
+bool parseArguments(int argc, char** argv, size_t& endlessBudget, std::string& endlessSpillPath);
+struct BoardState;
+bool processInput(GLFWwindow* window, std::vector<InputEvent>& events, const GameClock& clock, Stopwatch& stopwatch, BoardState& board, GameSnapshot& game, RenderThread& renderThread);
+void showStopwatch(GLFWwindow* window, const Stopwatch& stopwatch, double time);
+void resetBoard(BoardState& board);
+bool floodReveal(BoardState& board, int64_t column, int64_t row, float time);
+bool floodRevealEndless(BoardState& board, int64_t x, int64_t y, float time);
+void pushEndlessCell(BoardState& board, int64_t x, int64_t y, float time, float distance);
+void followCamera(BoardState& board, const Camera& camera);
+void stepHistory(BoardState& board, Stopwatch& stopwatch, uint64_t tick, int64_t steps, double time);
+void sendBoard(BoardState& board, RenderThread& renderThread);
+void fitCamera(BoardState& board, Camera& camera);
+bool cellAt(BoardState& board, const Camera& camera, glm::dvec2 point, int64_t& column, int64_t& row);
+
+// what the GLFW callbacks need, reachable through the window user pointer
+struct WindowState
+{
+    RenderThread* renderThread = NULL;
+    // filled by the callbacks during glfwPollEvents, drained right after on the same thread
+    std::vector<InputEvent> events;
+    // latest framebuffer size, for the camera
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+};
+
+// which cells are open, plus what the render thread has not accepted yet because its queue was full
+struct BoardState
+{
+    int columns = 0;
+    int rows = 0;
+    size_t mineCount = 0;
+    // the fixed board's rules and counters, specialized for its BOARD_COLUMNS x BOARD_ROWS size; one engine per
+    // topology, topology picks the one in play
+    GridTopology::Kind topology = GridTopology::SQUARE;
+    ExpertBoard engine;
+    ExpertHexBoard hexEngine;
+    ExpertTriangleBoard triangleEngine;
+    ExpertTorusBoard torusEngine;
+    // every move on the fixed board, for undo and redo; one per engine
+    BoardHistory<ExpertBoard> history;
+    BoardHistory<ExpertHexBoard> hexHistory;
+    BoardHistory<ExpertTriangleBoard> triangleHistory;
+    BoardHistory<ExpertTorusBoard> torusHistory;
+    // solver results by position hash, and the moves and per-tick hashes of the current game for checking a replay
+    HintCache hints;
+    ReplayLog replay;
+    // endless mode: the field has no bounds and the renderer shows a columns x rows window of it whose cell (0, 0)
+    // is the field's cell (windowX, windowY). World coordinates are field coordinates; the window moves with the
+    // camera, and the game starts around field cell (0, 0)
+    bool endless = false;
+    EndlessField endlessField;
+    int64_t windowX = 0;
+    int64_t windowY = 0;
+    std::vector<EndlessField::RevealedCell> endlessReveals;
+    bool resetPending = false;
+    std::vector<CellReveal> unsent;
+};
+
+// board: calls function with the fixed board's engine for the current topology. Each engine is its own type, so the
+// function is compiled once per topology and never looks the topology up again
+// ------------------------------------------------------------------------------------------------------------------
+template <typename Function>
+void withEngine(BoardState& board, const Function& function)
+{
+    switch (board.topology)
+    {
+    case GridTopology::HEX:
+        function(board.hexEngine);
+        break;
+    case GridTopology::TRIANGLE:
+        function(board.triangleEngine);
+        break;
+    case GridTopology::TORUS:
+        function(board.torusEngine);
+        break;
+    default:
+        function(board.engine);
+        break;
+    }
+}
+
+// board: like withEngine, with the engine's history as well
+// ---------------------------------------------------------
+template <typename Function>
+void withHistory(BoardState& board, const Function& function)
+{
+    switch (board.topology)
+    {
+    case GridTopology::HEX:
+        function(board.hexEngine, board.hexHistory);
+        break;
+    case GridTopology::TRIANGLE:
+        function(board.triangleEngine, board.triangleHistory);
+        break;
+    case GridTopology::TORUS:
+        function(board.torusEngine, board.torusHistory);
+        break;
+    default:
+        function(board.engine, board.history);
+        break;
+    }
+}
 
 // settings
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
-
-int main()
+const int BOARD_COLUMNS = 30;
+const int BOARD_ROWS = 16;
+const size_t BOARD_MINES = 99;
+// same density as the fixed board
+const unsigned int ENDLESS_MINES_PER_CHUNK = 844;
+const int ENDLESS_WINDOW = 1024;
+// chunks beyond this are evicted, the ones the player changed go to the spill file; defaults for
+// --endless-budget <KiB> and --endless-spill <path>
+const size_t ENDLESS_MEMORY_BUDGET = 64 * 1024 * 1024;
+const char* const ENDLESS_SPILL_PATH = "endless_spill.bin";
+
+int main(int argc, char** argv)
 {
+    size_t endlessBudget = ENDLESS_MEMORY_BUDGET;
+    std::string endlessSpillPath = ENDLESS_SPILL_PATH;
+    if (!parseArguments(argc, argv, endlessBudget, endlessSpillPath))
+        return -1;
 
     //Initialize GLFW and set opengl version
     glfwInit();
@@ -32,149 +170,686 @@ int main()
 
     // glfw window creation
     // --------------------
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "LearnOpenGL", NULL, NULL);
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Minesweeper", NULL, NULL);
     if (window == NULL)
     {
         std::cout << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
         return -1;
     }
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    // glad: load all OpenGL function pointers
-    // ---------------------------------------
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+
     {
-        std::cout << "Failed to initialize GLAD" << std::endl;
-        return -1;
+        // the render thread makes the context current on itself and owns everything GL
+        // ------------------------------------------------------------------------------
+        RenderThread renderThread(window, framebufferWidth, framebufferHeight);
+
+        WindowState windowState;
+        windowState.renderThread = &renderThread;
+        windowState.events.reserve(256);
+        windowState.framebufferWidth = framebufferWidth;
+        windowState.framebufferHeight = framebufferHeight;
+        glfwSetWindowUserPointer(window, &windowState);
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+
+        // input arrives through callbacks as it is delivered instead of being polled once per frame
+        glfwSetKeyCallback(window, key_callback);
+        glfwSetMouseButtonCallback(window, mouse_button_callback);
+        glfwSetCursorPosCallback(window, cursor_position_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+        // unaccelerated motion straight from the device; GLFW applies it while the cursor is disabled
+        if (glfwRawMouseMotionSupported())
+            glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+
+        // game logic runs in fixed GameClock::STEP ticks no matter how fast frames are presented
+        GameClock clock;
+        Stopwatch stopwatch;
+        GameSnapshot game;
+        game.tickTime = clock.TimeOfTick(0);
+
+        BoardState board;
+        board.columns = BOARD_COLUMNS;
+        board.rows = BOARD_ROWS;
+        board.mineCount = BOARD_MINES;
+        board.endlessField.SetMemoryBudget(endlessBudget, endlessSpillPath);
+        resetBoard(board);
+        withEngine(board, [&](auto& engine) { game.mineCounter = engine.MineCounter(); });
+
+        game.camera.SetViewport(framebufferWidth, framebufferHeight);
+        fitCamera(board, game.camera);
+
+        while (!glfwWindowShouldClose(window) && !renderThread.HasFailed())
+        {
+            // glfw: sleep until the next tick unless an event (keys pressed/released, mouse moved etc.) arrives first
+            // -------------------------------------------------------------------------------------------------------
+            const double secondsUntilTick = std::chrono::duration<double>(clock.NextTick() - std::chrono::steady_clock::now()).count();
+            if (secondsUntilTick > 0.0)
+                glfwWaitEventsTimeout(secondsUntilTick);
+            else
+                glfwPollEvents();
+
+            // input, handled as soon as it wakes us up rather than on the next tick
+            // ----------------------------------------------------------------------
+            const bool inputChanged = processInput(window, windowState.events, clock, stopwatch, board, game, renderThread);
+            followCamera(board, game.camera);
+            sendBoard(board, renderThread);
+
+            // simulation
+            // ----------
+            game.camera.SetViewport(windowState.framebufferWidth, windowState.framebufferHeight);
+            const unsigned int ticks = clock.Advance(std::chrono::steady_clock::now());
+            const bool ticked = ticks > 0;
+            if (ticked)
+            {
+                game.camera.Update(std::chrono::duration<double>(GameClock::STEP * ticks).count());
+                game.tick = clock.Tick();
+                game.tickTime = clock.TimeOfTick(game.tick);
+                // the board is the same on every tick just advanced; its hash goes on the first, right after the moves
+                if (!board.endless)
+                    withEngine(board, [&](auto& engine) { board.replay.RecordTick(game.tick - ticks + 1, engine.Hash()); });
+                game.time = clock.Time();
+                game.stopwatch = stopwatch.Elapsed(game.time);
+                showStopwatch(window, stopwatch, game.time);
+            }
+
+            // the input time stays on the snapshot until the render thread has actually accepted one carrying it
+            if ((ticked || inputChanged) && renderThread.Submit(game))
+                game.inputTime = std::chrono::steady_clock::time_point();
+        }
+
+        glfwSetWindowUserPointer(window, NULL);
     }
 
-    std::cout << glGetString(GL_VERSION) << std:: endl;
+    // glfw: terminate, clearing all previously allocated GLFW resources.
+    // ------------------------------------------------------------------
+    glfwTerminate();
+    return 0;
+}
 
-    //DATA
-    float vertices[] =
+// process all input: handle every event the callbacks queued since the last call and react accordingly.
+// returns true if the game state changed, so it can be shown without waiting for the next tick
+// ---------------------------------------------------------------------------------------------------------
+bool processInput(GLFWwindow* window, std::vector<InputEvent>& events, const GameClock& clock, Stopwatch& stopwatch, BoardState& board, GameSnapshot& game, RenderThread& renderThread)
+{
+    static bool recording = false;
+    static bool trackingLatency = false;
+    static bool cachingBoard = false;
+    static bool showingPerf = false;
+    static bool panning = false;
+    static glm::dvec2 lastCursor(0.0);
+    // wheel movement not yet turned into whole history steps
+    static double scrubbed = 0.0;
+    bool changed = false;
+
+    for (const InputEvent& event : events)
     {
-        //x     y       z     r     g   b
-        ////
-        //COORDINATES       |     COLOR           | TEX COORD
-        -0.5f,  -0.5f,  0.0f,  1.0f, 0.0f, 0.0f,   0.0f, 0.0f,        //bottom - left
-         0.5f,  -0.5f,  0.0f,  0.0f, 1.0f, 0.0f,   1.0f, 0.0f,          // bottom - right
-        -0.5f,   0.5f,  0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 1.0f,          //top - left
-         0.5f,   0.5f,  0.0f,  1.0f, 0.0f, 0.0f,   1.0f, 1.0f            //top -  right
-    };
+        if (event.type == InputEvent::MOUSE_BUTTON && event.action == GLFW_PRESS)
+        {
+            const glm::dvec2 point = windowToFramebuffer(window, event.x, event.y);
+            if (event.code == GLFW_MOUSE_BUTTON_LEFT && point.y < Hud::BAR_HEIGHT)
+            {
+                // the face button starts a new game
+                if (Hud::HitFace(point.x, point.y, game.camera.ViewportWidth()))
+                {
+                    stopwatch.Reset();
+                    resetBoard(board);
+                }
+            }
+            else if (event.code == GLFW_MOUSE_BUTTON_LEFT)
+            {
+                const double time = clock.TimeAt(event.time);
+                Board::Status status = Board::PLAYING;
+                withEngine(board, [&](auto& engine) { status = engine.GetStatus(); });
+                const bool playing = board.endless || status == Board::PLAYING;
+
+                int64_t column, row;
+                if (playing && cellAt(board, game.camera, point, column, row))
+                {
+                    // timed for the performance overlay
+                    const std::chrono::steady_clock::time_point revealStart = std::chrono::steady_clock::now();
+                    const bool moved = floodReveal(board, column, row, static_cast<float>(time));
+                    // the first click that opens something starts the stopwatch at the moment it was made, not at
+                    // the next tick; clicks on the HUD, off the board or on a flag do not
+                    if (moved && !stopwatch.HasStarted())
+                        stopwatch.Start(time);
+                    if (moved && !board.endless)
+                        board.replay.RecordMove(clock.Tick(), ReplayLog::REVEAL, static_cast<int>(column), static_cast<int>(row));
+                    game.revealMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - revealStart).count();
+
+                    // the engine knows the moment the game ends, no need to look at the board
+                    Board::Counters counters;
+                    withEngine(board, [&](auto& engine) { status = engine.GetStatus(); counters = engine.GetCounters(); });
+                    if (!board.endless && status != Board::PLAYING)
+                    {
+                        stopwatch.Stop(time);
+                        std::cout << (status == Board::WON ? "WON" : "LOST") << " IN " << std::fixed << std::setprecision(3) << stopwatch.Elapsed(time)
+                                  << "s, 3BV " << counters.threeBVCleared << "/" << counters.threeBV << std::defaultfloat << std::endl;
+                    }
+                }
+            }
+            else if (event.code == GLFW_MOUSE_BUTTON_RIGHT && !board.endless)
+            {
+                int64_t cellColumn, cellRow;
+                if (cellAt(board, game.camera, point, cellColumn, cellRow))
+                {
+                    // the fixed board's cells fit in an int
+                    const int column = static_cast<int>(cellColumn);
+                    const int row = static_cast<int>(cellRow);
+                    withHistory(board, [&](auto& engine, auto& history)
+                    {
+                        if (!engine.ToggleFlag(column, row, board.unsent))
+                            return;
+                        history.Record(engine);
+                        board.replay.RecordMove(clock.Tick(), ReplayLog::FLAG, column, row);
+                    });
+                }
+            }
+
+            if (game.inputTime == std::chrono::steady_clock::time_point())
+                game.inputTime = event.time;
+            changed = true;
+        }
+
+        // camera: drag with the middle button to pan, scroll to zoom around the cursor
+        if (event.type == InputEvent::MOUSE_BUTTON && event.code == GLFW_MOUSE_BUTTON_MIDDLE)
+        {
+            panning = event.action == GLFW_PRESS;
+            lastCursor = windowToFramebuffer(window, event.x, event.y);
+        }
+        if (event.type == InputEvent::CURSOR_MOVE && panning)
+        {
+            const glm::dvec2 cursor = windowToFramebuffer(window, event.x, event.y);
+            game.camera.Pan(cursor.x - lastCursor.x, cursor.y - lastCursor.y);
+            lastCursor = cursor;
+            changed = true;
+        }
+        // ctrl+wheel scrubs through the fixed board's history instead: up goes back, down forward
+        if (event.type == InputEvent::SCROLL && (event.mods & GLFW_MOD_CONTROL) && !board.endless)
+        {
+            scrubbed += event.y;
+            const int64_t steps = static_cast<int64_t>(scrubbed);
+            scrubbed -= static_cast<double>(steps);
+            if (steps != 0)
+            {
+                stepHistory(board, stopwatch, clock.Tick(), -steps, clock.TimeAt(event.time));
+                showStopwatch(window, stopwatch, clock.Time());
+                changed = true;
+            }
+            continue;
+        }
+        if (event.type == InputEvent::SCROLL)
+        {
+            double x, y;
+            glfwGetCursorPos(window, &x, &y);
+            game.camera.ZoomAt(windowToFramebuffer(window, x, y), std::pow(1.25, event.y));
+        }
+
+        if (event.type != InputEvent::KEY || event.action != GLFW_PRESS)
+            continue;
+
+        RenderCommand command;
+        switch (event.code)
+        {
+        case GLFW_KEY_ESCAPE:
+            glfwSetWindowShouldClose(window, true);
+            break;
+        case GLFW_KEY_F12:
+            command.type = RenderCommand::SCREENSHOT;
+            command.path = "screenshot_" + std::to_string(std::time(nullptr)) + ".png";
+            renderThread.Submit(std::move(command));
+            break;
+        case GLFW_KEY_F9:
+            command.type = recording ? RenderCommand::STOP_RECORDING : RenderCommand::START_RECORDING;
+            command.path = "recording_" + std::to_string(std::time(nullptr));
+            if (renderThread.Submit(std::move(command)))
+                recording = !recording;
+            break;
+        case GLFW_KEY_F5:
+            // stops a running stopwatch, resets a stopped one
+            if (stopwatch.IsRunning())
+            {
+                stopwatch.Stop(clock.TimeAt(event.time));
+                std::cout << "TIME: " << std::fixed << std::setprecision(3) << stopwatch.Elapsed(clock.Time()) << "s" << std::defaultfloat << std::endl;
+            }
+            else
+            {
+                stopwatch.Reset();
+                resetBoard(board);
+            }
+            showStopwatch(window, stopwatch, clock.Time());
+            break;
+        case GLFW_KEY_F3:
+            command.type = RenderCommand::PERF_OVERLAY;
+            command.enabled = !showingPerf;
+            if (renderThread.Submit(std::move(command)))
+                showingPerf = !showingPerf;
+            break;
+        case GLFW_KEY_H:
+            game.highlighted = !game.highlighted;
+            changed = true;
+            break;
+        case GLFW_KEY_F6:
+            // switches between the fixed board and endless mode, starting a new game either way
+            board.endless = !board.endless;
+            board.columns = board.endless ? ENDLESS_WINDOW : BOARD_COLUMNS;
+            board.rows = board.endless ? ENDLESS_WINDOW : BOARD_ROWS;
+            stopwatch.Reset();
+            resetBoard(board);
+            fitCamera(board, game.camera);
+            if (board.endless)
+                game.camera.ZoomAt(glm::dvec2(game.camera.ViewportWidth(), game.camera.ViewportHeight()) * 0.5, 24.0 / game.camera.Zoom());
+            changed = true;
+            break;
+        case GLFW_KEY_F4:
+            // cycles the fixed board through square, hex, triangle and torus grids, starting a new game
+            if (board.endless)
+                break;
+            board.topology = static_cast<GridTopology::Kind>((board.topology + 1) % GridTopology::KIND_COUNT);
+            stopwatch.Reset();
+            resetBoard(board);
+            fitCamera(board, game.camera);
+            changed = true;
+            break;
+        case GLFW_KEY_Z:
+        case GLFW_KEY_Y:
+            // ctrl+z undoes the last move on the fixed board, ctrl+y or ctrl+shift+z redoes it, as often as wanted;
+            // undoing a lost game makes it playable again for practice
+            if (board.endless || !(event.mods & GLFW_MOD_CONTROL))
+                break;
+            stepHistory(board, stopwatch, clock.Tick(), event.code == GLFW_KEY_Y || (event.mods & GLFW_MOD_SHIFT) ? 1 : -1, clock.TimeAt(event.time));
+            showStopwatch(window, stopwatch, clock.Time());
+            changed = true;
+            break;
+        case GLFW_KEY_F1:
+            // hint: a move that follows from the board as shown, solved once per position
+            if (board.endless)
+                break;
+            withEngine(board, [&](auto& engine)
+            {
+                const std::chrono::steady_clock::time_point solveStart = std::chrono::steady_clock::now();
+                Board::Hint hint;
+                if (!board.hints.Find(engine.Hash(), hint))
+                {
+                    hint = engine.FindHint();
+                    board.hints.Insert(engine.Hash(), hint);
+                }
+                game.solverMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - solveStart).count();
+                if (hint.found)
+                    std::cout << "HINT: " << (hint.mine ? "FLAG " : "REVEAL ") << hint.column << ", " << hint.row << std::endl;
+                else
+                    std::cout << "HINT: NOTHING IS CERTAIN" << std::endl;
+            });
+            changed = true;
+            break;
+        case GLFW_KEY_F10:
+            // replays the moves of this game on a fresh board and checks them against every tick's hash
+            if (board.endless)
+                break;
+            withEngine(board, [&](auto& engine)
+            {
+                const int64_t desync = board.replay.FirstDesync<std::decay_t<decltype(engine)>>();
+                if (desync < 0)
+                    std::cout << "REPLAY OK: " << board.replay.MoveCount() << " MOVES, " << board.replay.ChecksumCount() << " CHECKSUMS" << std::endl;
+                else
+                    std::cout << "REPLAY DESYNC AT TICK " << desync << std::endl;
+            });
+            break;
+        case GLFW_KEY_F7:
+            command.type = RenderCommand::CACHE_BOARD;
+            command.enabled = !cachingBoard;
+            if (renderThread.Submit(std::move(command)))
+                cachingBoard = !cachingBoard;
+            break;
+        case GLFW_KEY_F8:
+            command.type = RenderCommand::TRACK_LATENCY;
+            command.enabled = !trackingLatency;
+            if (renderThread.Submit(std::move(command)))
+                trackingLatency = !trackingLatency;
+            break;
+        }
+    }
 
-    unsigned int indices[] =
+    // counters the HUD shows, read straight from the engine
+    withEngine(board, [&](auto& engine)
     {
-        0, 1, 2,
-        1, 2, 3
-    };
-
-
-    //VAO GENERATION
-    const VertexArrayObject VAO1;
-    VAO1.Bind();
-
-    const VertexBufferObject VBO1(vertices, sizeof(vertices));
-    const IndexBufferObject IBO1(indices, sizeof(indices));
-
-    //COORDS
-    const int numCoords = 3;
-    const int numColors = 3;
-    const int numTextCoords = 2;
-    const int stride = (numCoords + numColors + numTextCoords) * sizeof(float);
-
-    VAO1.LinkAttrib(VBO1, 0, numCoords, GL_FLOAT, stride, (void*)0);
-
-    VAO1.LinkAttrib(VBO1, 1, numColors, GL_FLOAT, stride, (void*)(numCoords * sizeof(float)));
-
-    VAO1.LinkAttrib(VBO1, 2, numTextCoords, GL_FLOAT, stride, (void*)((numCoords + numColors) * sizeof(float)));
+        game.mineCounter = board.endless ? 0 : engine.MineCounter();
+        game.won = !board.endless && engine.GetStatus() == Board::WON;
+        game.lost = !board.endless && engine.GetStatus() == Board::LOST;
+    });
+    game.hintHits = board.hints.Hits();
+    game.hintMisses = board.hints.Misses();
+
+    events.clear();
+    return changed;
+}
 
-    VBO1.Unbind();
-    VAO1.Unbind();
-    IBO1.Unbind();
+// board: start over with every cell hidden
+// ---------------------------------------
+void resetBoard(BoardState& board)
+{
+    // a fresh seed per game; the seed alone is enough to regenerate the board
+    const uint64_t seed = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    if (board.endless)
+        board.endlessField.Reset(seed, ENDLESS_MINES_PER_CHUNK);
+    else
+        withHistory(board, [&](auto& engine, auto& history)
+        {
+            engine.Reset(board.columns, board.rows, board.mineCount, seed);
+            history.Reset(engine);
+            board.replay.Start(board.columns, board.rows, board.mineCount, seed);
+        });
+    board.hints.Clear();
+    board.windowX = -board.columns / 2;
+    board.windowY = -board.rows / 2;
+#ifdef _DEBUG
+    // debug builds only, so a board can be reproduced from the log
+    std::cout << (board.endless ? "ENDLESS SEED: " : "BOARD SEED: ") << seed << std::endl;
+#endif
+    board.resetPending = true;
+    board.unsent.clear();
+}
 
-    //TEXTURE GENERATION
+// board: move through the fixed board's history by steps, back when negative, as far as it goes. The stopwatch
+// follows the game: it stops when the move to a finished game is redone, carries on when the move that finished it
+// is undone, and starts over at the first entry, where the board has not been played yet
+// ---------------------------------------------------------------------------------------------------------------
+void stepHistory(BoardState& board, Stopwatch& stopwatch, uint64_t tick, int64_t steps, double time)
+{
+    withHistory(board, [&](auto& engine, auto& history)
+    {
+        const int64_t last = static_cast<int64_t>(history.Entries()) - 1;
+        const int64_t cursor = static_cast<int64_t>(history.Cursor());
+        const int64_t target = std::max<int64_t>(0, std::min(last, cursor + steps));
+        if (!history.Seek(engine, static_cast<size_t>(target), static_cast<float>(time), board.unsent))
+            return;
+        // a jump is as many single steps as far as the replay is concerned
+        for (int64_t step = cursor; step != target; step += target > cursor ? 1 : -1)
+            board.replay.RecordMove(tick, target > cursor ? ReplayLog::REDO : ReplayLog::UNDO);
+
+        if (target == 0)
+        {
+            stopwatch.Reset();
+            return;
+        }
+        if (!stopwatch.HasStarted())
+            stopwatch.Start(time);
+        if (engine.GetStatus() == Board::PLAYING)
+            stopwatch.Resume(time);
+        else
+            stopwatch.Stop(time);
+    });
+}
 
+// board: open the clicked cell, flooding outwards through cells with no adjacent mines, or chord when it is an
+// open number. Each cell records how many steps it is from the click, which is all the renderer needs to play
+// the ripple on the GPU. False when nothing changed
+// ------------------------------------------------------------------------------------------------------------
+bool floodReveal(BoardState& board, int64_t cellColumn, int64_t cellRow, float time)
+{
+    if (board.endless)
+        return floodRevealEndless(board, cellColumn, cellRow, time);
+    // the fixed board's cells fit in an int
+    const int column = static_cast<int>(cellColumn);
+    const int row = static_cast<int>(cellRow);
+    bool moved = false;
+    withHistory(board, [&](auto& engine, auto& history)
+    {
+        moved = engine.IsRevealed(column, row) ? engine.Chord(column, row, time, board.unsent)
+                                               : engine.Reveal(column, row, time, board.unsent);
+        if (moved)
+            history.Record(engine);
+    });
+    return moved;
+}
 
-    const char* filePath ="res/texture/brick.png";
-    int width, height, colorChannel;
+// board: endless mode floods the unbounded field from field cell (x, y), which generates chunks as the flood reaches
+// them. The whole flood happens; only the part of it inside the rendered window is passed on, the rest is sent when
+// the window gets there. False when nothing opened
+// -----------------------------------------------------------------------------------------------------------------
+bool floodRevealEndless(BoardState& board, int64_t x, int64_t y, float time)
+{
+    board.endlessReveals.clear();
+    board.endlessField.Reveal(x, y, board.endlessReveals);
+    for (const EndlessField::RevealedCell& revealed : board.endlessReveals)
+        pushEndlessCell(board, revealed.x, revealed.y, time, revealed.distance);
+    return !board.endlessReveals.empty();
+}
 
-    unsigned char* data = stbi_load(filePath, &width, &height, &colorChannel, 4);
-    unsigned int texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
+// board: queues an open field cell for the renderer if it is inside the window
+// -----------------------------------------------------------------------------
+void pushEndlessCell(BoardState& board, int64_t x, int64_t y, float time, float distance)
+{
+    const int64_t column = x - board.windowX;
+    const int64_t row = y - board.windowY;
+    if (column < 0 || column >= board.columns || row < 0 || row >= board.rows)
+        return;
+    const size_t cell = static_cast<size_t>(row) * board.columns + static_cast<size_t>(column);
+    const uint32_t face = board.endlessField.IsMine(x, y) ? CellReveal::MINE : static_cast<uint32_t>(board.endlessField.AdjacentMines(x, y));
+    board.unsent.push_back(CellReveal{ static_cast<uint32_t>(cell), time, distance, face });
+}
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+// board: endless mode moves the window once the camera strays a quarter of it from its center, putting it back
+// around the camera on whole chunks. The renderer starts a new board there, filled with what is already open
+// ------------------------------------------------------------------------------------------------------------
+void followCamera(BoardState& board, const Camera& camera)
+{
+    if (!board.endless)
+        return;
+    const glm::dvec2 center = camera.Center();
+    const double offsetX = center.x - (static_cast<double>(board.windowX) + board.columns * 0.5);
+    const double offsetY = center.y - (static_cast<double>(board.windowY) + board.rows * 0.5);
+    if (std::abs(offsetX) <= board.columns * 0.25 && std::abs(offsetY) <= board.rows * 0.25)
+        return;
+
+    const int64_t chunk = EndlessField::CHUNK_SIZE;
+    board.windowX = static_cast<int64_t>(std::floor(center.x / chunk)) * chunk - board.columns / 2;
+    board.windowY = static_cast<int64_t>(std::floor(center.y / chunk)) * chunk - board.rows / 2;
+    board.resetPending = true;
+    board.unsent.clear();
+    // shown as long open, without a ripple
+    board.endlessField.ForEachRevealed(board.windowX, board.windowY, board.windowX + board.columns, board.windowY + board.rows,
+                                       [&](int64_t x, int64_t y) { pushEndlessCell(board, x, y, 0.0f, 0.0f); });
+}
 
-    if (data)
+// board: hand new boards and reveals to the render thread; whatever does not fit in its queue is retried next time
+// ----------------------------------------------------------------------------------------------------------------
+void sendBoard(BoardState& board, RenderThread& renderThread)
+{
+    if (board.resetPending)
     {
-	    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-	    glGenerateMipmap(GL_TEXTURE_2D);
+        RenderCommand command;
+        command.type = RenderCommand::NEW_BOARD;
+        command.width = board.columns;
+        command.height = board.rows;
+        command.topology = board.endless ? GridTopology::SQUARE : board.topology;
+        command.originX = board.endless ? board.windowX : 0;
+        command.originY = board.endless ? board.windowY : 0;
+        if (!renderThread.Submit(std::move(command)))
+            return;
+        board.resetPending = false;
     }
-    else
+
+    if (!board.unsent.empty())
     {
-	    std::cout << "ERROR LOADING TEXTURE AT " << filePath << std::endl;
+        RenderCommand command;
+        command.type = RenderCommand::REVEAL;
+        command.reveals = board.unsent;
+        if (renderThread.Submit(std::move(command)))
+            board.unsent.clear();
     }
+}
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
-
-    //SHADER GENERATION
-    const ShaderProgram shader1("res/shaders/basic/vertex.shader", "res/shaders/basic/fragment.shader");
-    const ShaderProgram shader2("res/shaders/basic/vertex.shader", "res/shaders/basic/fragmentUniform.shader");
+// camera: fit the whole board, whose size in world units depends on how its cells are laid out
+// -------------------------------------------------------------------------------------------
+void fitCamera(BoardState& board, Camera& camera)
+{
+    if (board.endless)
+    {
+        // centered on the field's cell (0, 0), where the window starts out centered too
+        camera.Fit(board.columns, board.rows);
+        camera.CenterOn(glm::dvec2(0.5));
+        return;
+    }
+    withEngine(board, [&](auto& engine)
+    {
+        double width, height;
+        std::decay_t<decltype(engine)>::TopologyType::Extent(board.columns, board.rows, width, height);
+        camera.Fit(width, height);
+    });
+}
 
-    shader2.Activate();
+// input: the cell under a framebuffer point, false when it is off the board. In endless mode it is a field cell,
+// and there is always one
+// --------------------------------------------------------------------------------------------------------------
+bool cellAt(BoardState& board, const Camera& camera, glm::dvec2 point, int64_t& column, int64_t& row)
+{
+    const glm::dvec2 world = camera.ScreenToCell(point);
+    if (board.endless)
+    {
+        column = static_cast<int64_t>(std::floor(world.x));
+        row = static_cast<int64_t>(std::floor(world.y));
+        return true;
+    }
+    bool inside = false;
+    withEngine(board, [&](auto& engine)
+    {
+        int cellColumn, cellRow;
+        inside = std::decay_t<decltype(engine)>::TopologyType::CellAt(world.x, world.y, board.columns, board.rows, cellColumn, cellRow);
+        column = cellColumn;
+        row = cellRow;
+    });
+    return inside;
+}
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    shader2.Set1i("ourTexture", 0);
+// command line: --endless-budget <KiB> bounds the memory endless mode keeps chunks in, so long sessions stay
+// bounded and a small budget spills early; --endless-spill <path> is where evicted chunks go. False on bad arguments
+// -----------------------------------------------------------------------------------------------------------------
+bool parseArguments(int argc, char** argv, size_t& endlessBudget, std::string& endlessSpillPath)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc || (argument != "--endless-budget" && argument != "--endless-spill"))
+        {
+            std::cout << "USAGE: " << argv[0] << " [--endless-budget <KiB>] [--endless-spill <path>]" << std::endl;
+            return false;
+        }
+        const char* value = argv[++i];
+        if (argument == "--endless-spill")
+        {
+            endlessSpillPath = value;
+            continue;
+        }
+        char* end = nullptr;
+        const unsigned long long kibibytes = std::strtoull(value, &end, 10);
+        if (end == value || *end != '\0' || value[0] == '-' || kibibytes > SIZE_MAX / 1024)
+        {
+            std::cout << "INVALID ENDLESS BUDGET: " << value << std::endl;
+            return false;
+        }
+        endlessBudget = static_cast<size_t>(kibibytes) * 1024;
+    }
+    return true;
+}
 
+// show the stopwatch in the title bar; only touches the window when the shown text changes
+// ----------------------------------------------------------------------------------------
+void showStopwatch(GLFWwindow* window, const Stopwatch& stopwatch, double time)
+{
+    static char shown[64] = "";
+    char title[64];
+    if (!stopwatch.HasStarted())
+        std::snprintf(title, sizeof(title), "Minesweeper");
+    else if (stopwatch.IsRunning())
+        std::snprintf(title, sizeof(title), "Minesweeper - %.1f", stopwatch.Elapsed(time));
+    else
+        std::snprintf(title, sizeof(title), "Minesweeper - %.3f", stopwatch.Elapsed(time));
 
-    while (!glfwWindowShouldClose(window))
+    if (std::string(title) != shown)
     {
-        // input
-        // -----
-        processInput(window);
-
-        // render
-        // ------
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        std::snprintf(shown, sizeof(shown), "%s", title);
+        glfwSetWindowTitle(window, title);
+    }
+}
 
+// glfw: input callbacks only record what happened and when; processInput acts on it
+// ----------------------------------------------------------------------------------
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    (void)scancode;
+    InputEvent event;
+    event.type = InputEvent::KEY;
+    event.code = key;
+    event.action = action;
+    event.mods = mods;
+    event.time = std::chrono::steady_clock::now();
+    static_cast<WindowState*>(glfwGetWindowUserPointer(window))->events.push_back(event);
+}
 
-        shader2.Activate();
-        VAO1.Bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    InputEvent event;
+    event.type = InputEvent::MOUSE_BUTTON;
+    event.code = button;
+    event.action = action;
+    event.mods = mods;
+    glfwGetCursorPos(window, &event.x, &event.y);
+    event.time = std::chrono::steady_clock::now();
+    static_cast<WindowState*>(glfwGetWindowUserPointer(window))->events.push_back(event);
+}
 
-        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-        // -------------------------------------------------------------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
-    }
+void cursor_position_callback(GLFWwindow* window, double x, double y)
+{
+    InputEvent event;
+    event.type = InputEvent::CURSOR_MOVE;
+    event.x = x;
+    event.y = y;
+    event.time = std::chrono::steady_clock::now();
+    static_cast<WindowState*>(glfwGetWindowUserPointer(window))->events.push_back(event);
+}
 
-    // glfw: terminate, clearing all previously allocated GLFW resources.
-    // ------------------------------------------------------------------
-    glfwTerminate();
-    return 0;
+void scroll_callback(GLFWwindow* window, double x, double y)
+{
+    InputEvent event;
+    event.type = InputEvent::SCROLL;
+    event.x = x;
+    event.y = y;
+    // GLFW does not pass modifiers with scroll events
+    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
+        event.mods = GLFW_MOD_CONTROL;
+    event.time = std::chrono::steady_clock::now();
+    static_cast<WindowState*>(glfwGetWindowUserPointer(window))->events.push_back(event);
 }
 
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-// ---------------------------------------------------------------------------------------------------------
-void processInput(GLFWwindow* window)
+// cursor positions are in window coordinates, the camera works in framebuffer pixels; they differ on high-DPI displays
+// -------------------------------------------------------------------------------------------------------------------
+glm::dvec2 windowToFramebuffer(GLFWwindow* window, double x, double y)
 {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
+    int windowWidth, windowHeight, framebufferWidth, framebufferHeight;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    if (windowWidth <= 0 || windowHeight <= 0)
+        return glm::dvec2(x, y);
+    return glm::dvec2(x * framebufferWidth / windowWidth, y * framebufferHeight / windowHeight);
 }
 
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
 // ---------------------------------------------------------------------------------------------
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
-    // make sure the viewport matches the new window dimensions; note that width and 
+    // the viewport belongs to the render thread's context, so it is resized there; note that width and
     // height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
-}
\ No newline at end of file
+    RenderCommand command;
+    command.type = RenderCommand::RESIZE;
+    command.width = width;
+    command.height = height;
+
+    if (WindowState* windowState = static_cast<WindowState*>(glfwGetWindowUserPointer(window)))
+    {
+        windowState->framebufferWidth = width;
+        windowState->framebufferHeight = height;
+        windowState->renderThread->Submit(std::move(command));
+    }
+}
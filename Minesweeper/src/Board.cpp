@@ -0,0 +1,528 @@
+#include "Board.h"
+#include <algorithm>
+
+template <typename Dims, typename Topology>
+BasicBoard<Dims, Topology>::BasicBoard()
+	: m_MineCount(0), m_Seed(0), m_Pool(nullptr), m_Generated(false), m_States(), m_Openings(), m_OpeningCleared(), m_Status(PLAYING), m_Hash(0),
+	  m_CellsReplaced(true), m_OpeningsReplaced(true)
+{
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Reset(const int columns, const int rows, const size_t mines, const uint64_t seed, ThreadPool* pool)
+{
+	m_Dims.Resize(columns, rows);
+	m_Seed = seed;
+	m_Pool = pool;
+	m_Generated = false;
+	m_Mines.Clear(columns, rows);
+	Dims::Assign(m_States, m_Dims.Cells(), HIDDEN);
+	Dims::Assign(m_OpeningCleared, m_Dims.Cells(), false);
+	m_Status = PLAYING;
+	m_Hash = 0;
+
+	//Until the mines are placed the counters assume the requested count; the generator clamps
+	//it to what fits around the first click
+	const size_t cells = m_Dims.Cells();
+	m_MineCount = std::min(mines, cells);
+	m_Counters = Counters();
+	m_Counters.unrevealedSafe = cells - m_MineCount;
+
+	const size_t blocks = static_cast<size_t>(BlockColumns()) * ((m_Dims.Rows() + SNAPSHOT_BLOCK - 1) / SNAPSHOT_BLOCK);
+	m_BlockChanged.assign(blocks, false);
+	m_OpeningRunChanged.assign((cells + SNAPSHOT_CELLS - 1) / SNAPSHOT_CELLS, false);
+	m_ChangedBlocks.clear();
+	m_ChangedOpeningRuns.clear();
+	m_CellsReplaced = true;
+	m_OpeningsReplaced = true;
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Generate(const int safeColumn, const int safeRow)
+{
+	if constexpr (Topology::KIND == GridTopology::SQUARE)
+	{
+		//Counted while the mines are placed, with the square grid's own kernel
+		m_Mines.Generate(m_Dims.Columns(), m_Dims.Rows(), m_MineCount, m_Seed, safeColumn, safeRow, m_Pool);
+	}
+	else
+	{
+		//The click and its neighbors on this topology stay clear, then counts come from its table
+		size_t safe[MineField::MAX_SAFE_CELLS];
+		size_t safeCount = 0;
+		safe[safeCount++] = Index(safeColumn, safeRow);
+		ForEachNeighbor(safeColumn, safeRow, [&](const int x, const int y) { safe[safeCount++] = Index(x, y); });
+		std::sort(safe, safe + safeCount);
+		safeCount = static_cast<size_t>(std::unique(safe, safe + safeCount) - safe);
+		m_Mines.Place(m_Dims.Columns(), m_Dims.Rows(), m_MineCount, m_Seed, safe, safeCount, m_Pool);
+		m_Mines.template Recount<Topology>(m_Pool);
+	}
+	m_MineCount = m_Mines.Mines();
+	m_Counters.unrevealedSafe = m_Dims.Cells() - m_MineCount;
+	m_Generated = true;
+	//Undoing past the first reveal and clicking elsewhere gives different mines, and the hash says so
+	m_Hash ^= LayoutKey(Index(safeColumn, safeRow));
+	Analyze();
+}
+
+template <typename Dims, typename Topology>
+bool BasicBoard<Dims, Topology>::BordersOpening(const int column, const int row) const
+{
+	bool borders = false;
+	ForEachNeighbor(column, row, [&](const int x, const int y) { borders |= m_Openings[Index(x, y)] != 0; });
+	return borders;
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Analyze()
+{
+	const size_t cells = m_Dims.Cells();
+	Dims::Assign(m_Openings, cells, OpeningId(0));
+	Dims::Assign(m_OpeningCleared, cells, false);
+	m_OpeningsReplaced = true;
+	size_t openings = 0;
+	size_t threeBV = 0;
+
+	//Every cell is pushed at most once, right after it is labelled
+	typename Dims::template Array<uint32_t> stack;
+	Dims::Assign(stack, cells, uint32_t(0));
+	size_t stackSize = 0;
+
+	//OPENINGS, each one flood filled once
+	for (int row = 0; row < m_Dims.Rows(); row++)
+	{
+		for (int column = 0; column < m_Dims.Columns(); column++)
+		{
+			if (m_Openings[Index(column, row)] || m_Mines.IsMine(column, row) || m_Mines.AdjacentMines(column, row) > 0)
+				continue;
+
+			const OpeningId opening = static_cast<OpeningId>(++openings);
+			threeBV++;
+			m_Openings[Index(column, row)] = opening;
+			stack[stackSize++] = static_cast<uint32_t>(Index(column, row));
+			while (stackSize > 0)
+			{
+				const uint32_t cell = stack[--stackSize];
+				const int x = static_cast<int>(cell % m_Dims.Columns());
+				const int y = static_cast<int>(cell / m_Dims.Columns());
+				ForEachNeighbor(x, y, [&](const int nx, const int ny)
+				{
+					if (m_Openings[Index(nx, ny)] || m_Mines.AdjacentMines(nx, ny) > 0)
+						return;
+					m_Openings[Index(nx, ny)] = opening;
+					stack[stackSize++] = static_cast<uint32_t>(Index(nx, ny));
+				});
+			}
+		}
+	}
+
+	//NUMBERS NOT NEXT TO AN OPENING each take a click of their own
+	for (int row = 0; row < m_Dims.Rows(); row++)
+		for (int column = 0; column < m_Dims.Columns(); column++)
+			threeBV += !m_Openings[Index(column, row)] && !m_Mines.IsMine(column, row) && !BordersOpening(column, row);
+	m_Counters.threeBV = threeBV;
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Open(const size_t cell, const float time, const float distance, std::vector<CellReveal>& reveals)
+{
+	const int column = static_cast<int>(cell % m_Dims.Columns());
+	const int row = static_cast<int>(cell / m_Dims.Columns());
+	m_States[cell] = REVEALED;
+	reveals.push_back(CellReveal{ static_cast<uint32_t>(cell), time, distance, Face(column, row) });
+	CellChanged(column, row);
+	m_Hash ^= CellKey(cell, REVEALED);
+	if (m_Mines.IsMine(column, row))
+	{
+		m_Counters.exploded++;
+		m_Status = LOST;
+		return;
+	}
+
+	m_Counters.unrevealedSafe--;
+	const OpeningId opening = m_Openings[cell];
+	if (opening)
+	{
+		if (!m_OpeningCleared[opening - 1])
+		{
+			m_OpeningCleared[opening - 1] = true;
+			OpeningChanged(opening);
+			m_Counters.threeBVCleared++;
+		}
+	}
+	else
+	{
+		//A number counts on its own unless an opening it borders uncovers it
+		m_Counters.threeBVCleared += !BordersOpening(column, row);
+	}
+
+	if (m_Counters.unrevealedSafe == 0 && m_Status == PLAYING)
+		m_Status = WON;
+}
+
+//Breadth first, so the order of reveals is also the order of distances. Flags stop the flood.
+//The seeds are already in reveals, in order of distance, so any number of them flood in one pass.
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Flood(const size_t first, const float time, std::vector<CellReveal>& reveals)
+{
+	for (size_t next = first; next < reveals.size(); next++)
+	{
+		const CellReveal current = reveals[next];
+		if (!m_Openings[current.cell])
+			continue;
+		const int x = static_cast<int>(current.cell % m_Dims.Columns());
+		const int y = static_cast<int>(current.cell / m_Dims.Columns());
+		ForEachNeighbor(x, y, [&](const int nx, const int ny)
+		{
+			if (m_States[Index(nx, ny)] == HIDDEN)
+				Open(Index(nx, ny), time, current.distance + 1.0f, reveals);
+		});
+	}
+}
+
+template <typename Dims, typename Topology>
+bool BasicBoard<Dims, Topology>::Reveal(const int column, const int row, const float time, std::vector<CellReveal>& reveals)
+{
+	if (m_Status != PLAYING || !Contains(column, row) || m_States[Index(column, row)] != HIDDEN)
+		return false;
+	if (!m_Generated)
+		Generate(column, row);
+	const size_t first = reveals.size();
+	Open(Index(column, row), time, 0.0f, reveals);
+	Flood(first, time, reveals);
+	return true;
+}
+
+template <typename Dims, typename Topology>
+bool BasicBoard<Dims, Topology>::Chord(const int column, const int row, const float time, std::vector<CellReveal>& reveals)
+{
+	if (m_Status != PLAYING || !Contains(column, row) || m_States[Index(column, row)] != REVEALED)
+		return false;
+	const int number = m_Mines.AdjacentMines(column, row);
+	if (number == 0)
+		return false;
+
+	int flags = 0;
+	int hidden = 0;
+	ForEachNeighbor(column, row, [&](const int x, const int y)
+	{
+		flags += m_States[Index(x, y)] == FLAGGED;
+		hidden += m_States[Index(x, y)] == HIDDEN;
+	});
+	if (flags != number || hidden == 0)
+		return false;
+
+	//BATCHED: every hidden neighbor is a seed one step from the number, and a single flood opens
+	//them all, so overlapping floods never revisit a cell and the reveals arrive as one batch
+	const size_t first = reveals.size();
+	ForEachNeighbor(column, row, [&](const int x, const int y)
+	{
+		if (m_States[Index(x, y)] == HIDDEN)
+			Open(Index(x, y), time, 1.0f, reveals);
+	});
+	Flood(first, time, reveals);
+	return true;
+}
+
+template <typename Dims, typename Topology>
+bool BasicBoard<Dims, Topology>::ToggleFlag(const int column, const int row, std::vector<CellReveal>& changes)
+{
+	if (m_Status != PLAYING || !Contains(column, row))
+		return false;
+	CellState& state = m_States[Index(column, row)];
+	if (state == REVEALED)
+		return false;
+	CellChanged(column, row);
+	//Flagging and unflagging are the same XOR
+	m_Hash ^= CellKey(Index(column, row), FLAGGED);
+
+	if (state == FLAGGED)
+	{
+		state = HIDDEN;
+		m_Counters.flags--;
+	}
+	else
+	{
+		state = FLAGGED;
+		m_Counters.flags++;
+	}
+	changes.push_back(CellReveal{ static_cast<uint32_t>(Index(column, row)), -1.0f, 0.0f, Face(column, row) });
+	return true;
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::CellChanged(const int column, const int row)
+{
+	const size_t block = BlockOf(column, row);
+	if (!m_BlockChanged[block])
+	{
+		m_BlockChanged[block] = true;
+		m_ChangedBlocks.push_back(static_cast<uint32_t>(block));
+	}
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::OpeningChanged(const OpeningId opening)
+{
+	const size_t run = (opening - 1) / SNAPSHOT_CELLS;
+	if (!m_OpeningRunChanged[run])
+	{
+		m_OpeningRunChanged[run] = true;
+		m_ChangedOpeningRuns.push_back(static_cast<uint32_t>(run));
+	}
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::ForgetChanges()
+{
+	for (const uint32_t block : m_ChangedBlocks)
+		m_BlockChanged[block] = false;
+	for (const uint32_t run : m_ChangedOpeningRuns)
+		m_OpeningRunChanged[run] = false;
+	m_ChangedBlocks.clear();
+	m_ChangedOpeningRuns.clear();
+	m_CellsReplaced = false;
+	m_OpeningsReplaced = false;
+}
+
+//Cells outside the board in edge blocks stay HIDDEN
+template <typename Dims, typename Topology>
+std::shared_ptr<const typename BasicBoard<Dims, Topology>::SnapshotChunks::Chunk> BasicBoard<Dims, Topology>::CopyBlock(const size_t block) const
+{
+	const std::shared_ptr<typename SnapshotChunks::Chunk> chunk = std::make_shared<typename SnapshotChunks::Chunk>();
+	chunk->fill(HIDDEN);
+	const int firstColumn = static_cast<int>(block % BlockColumns()) * SNAPSHOT_BLOCK;
+	const int firstRow = static_cast<int>(block / BlockColumns()) * SNAPSHOT_BLOCK;
+	const int width = std::min(SNAPSHOT_BLOCK, m_Dims.Columns() - firstColumn);
+	for (int y = 0; y < SNAPSHOT_BLOCK && firstRow + y < m_Dims.Rows(); y++)
+		std::copy_n(&m_States[Index(firstColumn, firstRow + y)], width, chunk->data() + y * SNAPSHOT_BLOCK);
+	return chunk;
+}
+
+template <typename Dims, typename Topology>
+std::shared_ptr<const typename BasicBoard<Dims, Topology>::SnapshotChunks::Chunk> BasicBoard<Dims, Topology>::CopyOpeningRun(const size_t run) const
+{
+	const std::shared_ptr<typename SnapshotChunks::Chunk> chunk = std::make_shared<typename SnapshotChunks::Chunk>();
+	chunk->fill(0);
+	const size_t first = run * SNAPSHOT_CELLS;
+	for (size_t i = 0; i < SNAPSHOT_CELLS && first + i < m_Dims.Cells(); i++)
+		(*chunk)[i] = m_OpeningCleared[first + i];
+	return chunk;
+}
+
+template <typename Dims, typename Topology>
+typename BasicBoard<Dims, Topology>::Snapshot BasicBoard<Dims, Topology>::Capture(const Snapshot* previous)
+{
+	Snapshot snapshot;
+	if (!previous || m_CellsReplaced)
+	{
+		snapshot.cells.Resize(m_BlockChanged.size());
+		for (size_t block = 0; block < m_BlockChanged.size(); block++)
+			snapshot.cells.Set(block, CopyBlock(block));
+	}
+	else
+	{
+		snapshot.cells = previous->cells;
+		for (const uint32_t block : m_ChangedBlocks)
+			snapshot.cells.Set(block, CopyBlock(block));
+	}
+
+	if (!previous || m_OpeningsReplaced)
+	{
+		snapshot.openings.Resize(m_OpeningRunChanged.size());
+		for (size_t run = 0; run < m_OpeningRunChanged.size(); run++)
+			snapshot.openings.Set(run, CopyOpeningRun(run));
+	}
+	else
+	{
+		snapshot.openings = previous->openings;
+		for (const uint32_t run : m_ChangedOpeningRuns)
+			snapshot.openings.Set(run, CopyOpeningRun(run));
+	}
+
+	snapshot.counters = m_Counters;
+	snapshot.status = m_Status;
+	snapshot.mineCount = m_MineCount;
+	snapshot.generated = m_Generated;
+	snapshot.hash = m_Hash;
+	ForgetChanges();
+	return snapshot;
+}
+
+template <typename Dims, typename Topology>
+void BasicBoard<Dims, Topology>::Restore(const Snapshot& target, const Snapshot& current, const float time, std::vector<CellReveal>& changes)
+{
+	SnapshotChunks::ForEachDifference(target.cells, current.cells, [&](const size_t block)
+	{
+		const typename SnapshotChunks::Chunk& chunk = *target.cells.Get(block);
+		const int firstColumn = static_cast<int>(block % BlockColumns()) * SNAPSHOT_BLOCK;
+		const int firstRow = static_cast<int>(block / BlockColumns()) * SNAPSHOT_BLOCK;
+		for (int y = 0; y < SNAPSHOT_BLOCK && firstRow + y < m_Dims.Rows(); y++)
+		{
+			for (int x = 0; x < SNAPSHOT_BLOCK && firstColumn + x < m_Dims.Columns(); x++)
+			{
+				const size_t cell = Index(firstColumn + x, firstRow + y);
+				const CellState state = static_cast<CellState>(chunk[y * SNAPSHOT_BLOCK + x]);
+				if (state == m_States[cell])
+					continue;
+				m_States[cell] = state;
+				changes.push_back(CellReveal{ static_cast<uint32_t>(cell), state == REVEALED ? time : -1.0f, 0.0f, Face(firstColumn + x, firstRow + y) });
+			}
+		}
+	});
+
+	SnapshotChunks::ForEachDifference(target.openings, current.openings, [&](const size_t run)
+	{
+		const typename SnapshotChunks::Chunk& chunk = *target.openings.Get(run);
+		const size_t first = run * SNAPSHOT_CELLS;
+		for (size_t i = 0; i < SNAPSHOT_CELLS && first + i < m_Dims.Cells(); i++)
+			m_OpeningCleared[first + i] = chunk[i] != 0;
+	});
+
+	//Mines stay as they are: going back before the first reveal just places them again on the next one
+	m_Counters = target.counters;
+	m_Status = target.status;
+	m_MineCount = target.mineCount;
+	m_Generated = target.generated;
+	m_Hash = target.hash;
+
+	//The board is now exactly target, so nothing is pending for the next Capture
+	ForgetChanges();
+}
+
+template <typename Dims, typename Topology>
+uint32_t BasicBoard<Dims, Topology>::Face(const int column, const int row) const
+{
+	switch (m_States[Index(column, row)])
+	{
+	case REVEALED:
+		return m_Mines.IsMine(column, row) ? CellReveal::MINE : static_cast<uint32_t>(m_Mines.AdjacentMines(column, row));
+	case FLAGGED:
+		return CellReveal::FLAG;
+	default:
+		return 0;
+	}
+}
+
+//ZOBRIST KEYS: splitmix64's finalizer over (seed, index) instead of a table of random numbers, so
+//keys cost no memory however large the board is. Indices 2 * cell and 2 * cell + 1 are a revealed
+//and a flagged cell, 2 * cells + cell the first click.
+template <typename Dims, typename Topology>
+uint64_t BasicBoard<Dims, Topology>::Key(const uint64_t index) const
+{
+	uint64_t key = m_Seed + index * 0x9E3779B97F4A7C15ull;
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+	return key ^ (key >> 31);
+}
+
+template <typename Dims, typename Topology>
+BoardTypes::Hint BasicBoard<Dims, Topology>::FindHint() const
+{
+	if (!m_Generated || m_Status != PLAYING)
+		return Hint();
+
+	//What a revealed number still says: its hidden neighbors hold mines of the mines not flagged yet
+	struct Constraint
+	{
+		size_t cells[Topology::MAX_NEIGHBORS];
+		int count;
+		int mines;
+	};
+	const auto constraintAt = [&](const int column, const int row, Constraint& constraint)
+	{
+		if (m_States[Index(column, row)] != REVEALED || m_Mines.AdjacentMines(column, row) == 0)
+			return false;
+		int flags = 0;
+		constraint.count = 0;
+		ForEachNeighbor(column, row, [&](const int x, const int y)
+		{
+			const CellState state = m_States[Index(x, y)];
+			flags += state == FLAGGED;
+			if (state == HIDDEN)
+				constraint.cells[constraint.count++] = Index(x, y);
+		});
+		constraint.mines = m_Mines.AdjacentMines(column, row) - flags;
+		return constraint.count > 0;
+	};
+	const auto hintAt = [&](const size_t cell, const bool mine)
+	{
+		Hint hint;
+		hint.found = true;
+		hint.mine = mine;
+		hint.column = static_cast<int>(cell % m_Dims.Columns());
+		hint.row = static_cast<int>(cell / m_Dims.Columns());
+		return hint;
+	};
+
+	//A mine is only suggested when no safe cell is found
+	Hint mine;
+
+	//SINGLE NUMBERS
+	for (int row = 0; row < m_Dims.Rows(); row++)
+	{
+		for (int column = 0; column < m_Dims.Columns(); column++)
+		{
+			Constraint constraint;
+			if (!constraintAt(column, row, constraint))
+				continue;
+			if (constraint.mines == 0)
+				return hintAt(constraint.cells[0], false);
+			if (constraint.mines == constraint.count && !mine.found)
+				mine = hintAt(constraint.cells[0], true);
+		}
+	}
+
+	//PAIRS: when b's hidden neighbors include all of a's, the ones only b has hold b.mines - a.mines.
+	//Such a b is a number next to a's first hidden cell.
+	for (int row = 0; row < m_Dims.Rows(); row++)
+	{
+		for (int column = 0; column < m_Dims.Columns(); column++)
+		{
+			Constraint a;
+			if (!constraintAt(column, row, a))
+				continue;
+			Hint safe;
+			const int firstColumn = static_cast<int>(a.cells[0] % m_Dims.Columns());
+			const int firstRow = static_cast<int>(a.cells[0] / m_Dims.Columns());
+			ForEachNeighbor(firstColumn, firstRow, [&](const int x, const int y)
+			{
+				Constraint b;
+				if (safe.found || (x == column && y == row) || !constraintAt(x, y, b) || b.count <= a.count)
+					return;
+				size_t only[Topology::MAX_NEIGHBORS];
+				int onlyCount = 0;
+				int shared = 0;
+				for (int i = 0; i < b.count; i++)
+				{
+					const bool inA = std::find(a.cells, a.cells + a.count, b.cells[i]) != a.cells + a.count;
+					shared += inA;
+					if (!inA)
+						only[onlyCount++] = b.cells[i];
+				}
+				if (shared != a.count)
+					return;
+				if (b.mines == a.mines)
+					safe = hintAt(only[0], false);
+				else if (b.mines - a.mines == onlyCount && !mine.found)
+					mine = hintAt(only[0], true);
+			});
+			if (safe.found)
+				return safe;
+		}
+	}
+	return mine;
+}
+
+//INSTANTIATIONS: the generic board and the three classic sizes on the square grid, and the generic
+//and expert boards on the other topologies
+template class BasicBoard<DynamicDims>;
+template class BasicBoard<StaticDims<9, 9>>;
+template class BasicBoard<StaticDims<16, 16>>;
+template class BasicBoard<StaticDims<30, 16>>;
+template class BasicBoard<DynamicDims, HexTopology>;
+template class BasicBoard<DynamicDims, TriangleTopology>;
+template class BasicBoard<DynamicDims, TorusTopology>;
+template class BasicBoard<StaticDims<30, 16>, HexTopology>;
+template class BasicBoard<StaticDims<30, 16>, TriangleTopology>;
+template class BasicBoard<StaticDims<30, 16>, TorusTopology>;
@@ -0,0 +1,245 @@
+#ifndef BOARD_CLASS
+#define BOARD_CLASS
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "CellReveal.h"
+#include "MineField.h"
+#include "PersistentArray.h"
+#include "StaticMineField.h"
+#include "ThreadPool.h"
+#include "Topology.h"
+
+//Board size chosen at run time, for custom games
+struct DynamicDims
+{
+	template <typename T>
+	using Array = std::vector<T>;
+	using Field = MineField;
+	using OpeningId = uint32_t;
+
+	int columns = 0;
+	int rows = 0;
+
+	void Resize(const int newColumns, const int newRows)
+	{
+		columns = newColumns;
+		rows = newRows;
+	}
+	int Columns() const { return columns; }
+	int Rows() const { return rows; }
+	size_t Cells() const { return static_cast<size_t>(columns) * rows; }
+
+	template <typename T>
+	static void Assign(std::vector<T>& array, const size_t size, const T& value) { array.assign(size, value); }
+};
+
+//Board size fixed at compile time: every bound, index and neighbor offset is a constant, state
+//lives in arrays inside the board and the per-cell loops can be unrolled
+template <int COLUMNS, int ROWS>
+struct StaticDims
+{
+	static constexpr size_t CELLS = static_cast<size_t>(COLUMNS) * ROWS;
+
+	template <typename T>
+	using Array = std::array<T, CELLS>;
+	using Field = StaticMineField<COLUMNS, ROWS>;
+	using OpeningId = typename std::conditional<CELLS <= 0xFFFF, uint16_t, uint32_t>::type;
+
+	void Resize(const int newColumns, const int newRows)
+	{
+		assert(newColumns == COLUMNS && newRows == ROWS);
+		(void)newColumns;
+		(void)newRows;
+	}
+	static constexpr int Columns() { return COLUMNS; }
+	static constexpr int Rows() { return ROWS; }
+	static constexpr size_t Cells() { return CELLS; }
+
+	template <typename T>
+	static void Assign(std::array<T, CELLS>& array, size_t, const T& value) { array.fill(value); }
+};
+
+//What every board size reports, so code reading it does not depend on the size
+struct BoardTypes
+{
+	enum Status
+	{
+		PLAYING,
+		WON,
+		LOST
+	};
+
+	struct Counters
+	{
+		//Safe cells still hidden; the game is won when this reaches 0
+		size_t unrevealedSafe = 0;
+		size_t flags = 0;
+		size_t exploded = 0;
+		//Bechtel's Board Benchmark Value: the fewest clicks that clear the board, i.e. every
+		//opening plus every numbered cell not next to one. Known once the mines are placed.
+		size_t threeBV = 0;
+		size_t threeBVCleared = 0;
+	};
+
+	//A move that follows from what the player can see, from BasicBoard::FindHint
+	struct Hint
+	{
+		bool found = false;
+		//Flag the cell rather than reveal it
+		bool mine = false;
+		int column = 0;
+		int row = 0;
+	};
+};
+
+//The rules of the fixed-size game on top of a mine field: revealing, flagging and chording, and
+//whether the game is won or lost. Every operation keeps the counters up to date as it changes
+//cells, so the end of the game and the HUD numbers never need a scan of the board.
+//Dims is DynamicDims or StaticDims; both boards have the same interface. Topology is one of the
+//policies in Topology.h and decides which cells are neighbors.
+template <typename Dims, typename Topology = SquareTopology>
+class BasicBoard : public BoardTypes
+{
+public:
+	using TopologyType = Topology;
+
+	//Side of the square blocks of cells undo snapshots share or copy
+	static constexpr int SNAPSHOT_BLOCK = 64;
+	static constexpr size_t SNAPSHOT_CELLS = SNAPSHOT_BLOCK * SNAPSHOT_BLOCK;
+	using SnapshotChunks = PersistentArray<uint8_t, SNAPSHOT_CELLS>;
+
+	//Everything a move can change, for undo. Cell states are kept per SNAPSHOT_BLOCK square block
+	//and the opening flags in runs of as many, each shared with every other snapshot of the game it
+	//is the same in, so a snapshot costs the blocks its move touched rather than the board.
+	struct Snapshot
+	{
+		SnapshotChunks cells;
+		SnapshotChunks openings;
+		Counters counters;
+		Status status = PLAYING;
+		size_t mineCount = 0;
+		bool generated = false;
+		uint64_t hash = 0;
+	};
+private:
+	enum CellState : uint8_t
+	{
+		HIDDEN,
+		REVEALED,
+		FLAGGED
+	};
+	using OpeningId = typename Dims::OpeningId;
+
+	Dims m_Dims;
+	size_t m_MineCount;
+	uint64_t m_Seed;
+	ThreadPool* m_Pool;
+	//Mines are placed on the first reveal, so it can never hit one
+	bool m_Generated;
+	typename Dims::Field m_Mines;
+	typename Dims::template Array<CellState> m_States;
+	//Opening (connected cells without adjacent mines) each cell belongs to, 0 for none;
+	//openings count towards 3BV once, the first time any of their cells opens
+	typename Dims::template Array<OpeningId> m_Openings;
+	//Indexed by opening - 1, as ids start at 1; there are never more openings than cells
+	typename Dims::template Array<bool> m_OpeningCleared;
+	Counters m_Counters;
+	Status m_Status;
+	//ZOBRIST HASH of the position: the XOR of a key per revealed or flagged cell, updated with each
+	//cell a move changes, and of a key for the first click once the mines are placed around it.
+	//The mines follow from the seed and the first click, so equal hashes also mean the same board.
+	uint64_t m_Hash;
+
+	//SNAPSHOT TRACKING: blocks of cells and runs of opening flags changed since the last Capture or
+	//Restore, once each in the lists; everything is copied when the whole board changed at once
+	std::vector<bool> m_BlockChanged;
+	std::vector<uint32_t> m_ChangedBlocks;
+	std::vector<bool> m_OpeningRunChanged;
+	std::vector<uint32_t> m_ChangedOpeningRuns;
+	bool m_CellsReplaced;
+	bool m_OpeningsReplaced;
+public:
+	BasicBoard();
+	//A new game. The mines are generated from seed on the first reveal, on pool if given.
+	//Static boards only accept their own size.
+	void Reset(int columns, int rows, size_t mines, uint64_t seed, ThreadPool* pool = nullptr);
+
+	//Each appends the cells it opens to reveals, breadth first with their distance from the
+	//click, and returns false when it did nothing. Nothing changes once the game is over.
+	bool Reveal(int column, int row, float time, std::vector<CellReveal>& reveals);
+	//Opens the hidden neighbors of a revealed number once as many of them are flagged, all of
+	//them in one flood fill
+	bool Chord(int column, int row, float time, std::vector<CellReveal>& reveals);
+	//Appends the cell to changes, with or without its flag
+	bool ToggleFlag(int column, int row, std::vector<CellReveal>& changes);
+
+	//The board now. Blocks unchanged since previous was captured or restored are shared with it,
+	//without previous every block is copied.
+	Snapshot Capture(const Snapshot* previous);
+	//Puts the board back the way it was at target, another snapshot of this game. current must be
+	//the one the board was last captured as or restored to: only blocks they do not share are
+	//copied, so undo, redo and jumps cost the blocks that differ. Cells that open, close or change
+	//flag are appended to changes for the renderer, hidden ones with a negative time.
+	void Restore(const Snapshot& target, const Snapshot& current, float time, std::vector<CellReveal>& changes);
+
+	Status GetStatus() const { return m_Status; }
+	const Counters& GetCounters() const { return m_Counters; }
+	//Mines minus flags, for the HUD
+	int MineCounter() const { return static_cast<int>(m_MineCount) - static_cast<int>(m_Counters.flags); }
+
+	bool IsRevealed(const int column, const int row) const { return m_States[Index(column, row)] == REVEALED; }
+	bool IsFlagged(const int column, const int row) const { return m_States[Index(column, row)] == FLAGGED; }
+	bool IsGenerated() const { return m_Generated; }
+	const typename Dims::Field& Mines() const { return m_Mines; }
+	int Columns() const { return m_Dims.Columns(); }
+	int Rows() const { return m_Dims.Rows(); }
+	uint64_t Seed() const { return m_Seed; }
+	//Identifies the position for caches and replay checksums, without looking at the board
+	uint64_t Hash() const { return m_Hash; }
+
+	//A safe cell to reveal, or failing that a mine to flag, that follows from the revealed numbers
+	//and the flags alone: single numbers whose hidden neighbors must all be safe or all mines, then
+	//pairs of numbers where one's hidden neighbors are a subset of the other's. Flags are trusted.
+	//Walks the whole board, so callers cache it by Hash.
+	Hint FindHint() const;
+private:
+	size_t Index(const int column, const int row) const { return static_cast<size_t>(row) * m_Dims.Columns() + column; }
+	bool Contains(const int column, const int row) const { return column >= 0 && column < m_Dims.Columns() && row >= 0 && row < m_Dims.Rows(); }
+	template <typename Visit>
+	void ForEachNeighbor(const int column, const int row, const Visit& visit) const { Topology::ForEachNeighbor(column, row, m_Dims.Columns(), m_Dims.Rows(), visit); }
+	void Generate(int safeColumn, int safeRow);
+	//Labels the openings and counts 3BV, once per game
+	void Analyze();
+	bool BordersOpening(int column, int row) const;
+	//Flood fill from the cells opened into reveals from first on
+	void Flood(size_t first, float time, std::vector<CellReveal>& reveals);
+	//Opens one hidden cell and updates the counters
+	void Open(size_t cell, float time, float distance, std::vector<CellReveal>& reveals);
+	int BlockColumns() const { return (m_Dims.Columns() + SNAPSHOT_BLOCK - 1) / SNAPSHOT_BLOCK; }
+	size_t BlockOf(const int column, const int row) const { return static_cast<size_t>(row / SNAPSHOT_BLOCK) * BlockColumns() + column / SNAPSHOT_BLOCK; }
+	void CellChanged(int column, int row);
+	void OpeningChanged(OpeningId opening);
+	void ForgetChanges();
+	uint64_t CellKey(const size_t cell, const CellState state) const { return Key(static_cast<uint64_t>(cell) * 2 + (state == FLAGGED)); }
+	//Key of the mine layout generated around the first click at cell
+	uint64_t LayoutKey(const size_t cell) const { return Key(static_cast<uint64_t>(m_Dims.Cells()) * 2 + cell); }
+	uint64_t Key(uint64_t index) const;
+	//What the renderer shows for the cell as it is now, a CellReveal face
+	uint32_t Face(int column, int row) const;
+	std::shared_ptr<const typename SnapshotChunks::Chunk> CopyBlock(size_t block) const;
+	std::shared_ptr<const typename SnapshotChunks::Chunk> CopyOpeningRun(size_t run) const;
+};
+
+//Defined in Board.cpp for these; other sizes and topologies need an instantiation there too
+using Board = BasicBoard<DynamicDims>;
+using BeginnerBoard = BasicBoard<StaticDims<9, 9>>;
+using IntermediateBoard = BasicBoard<StaticDims<16, 16>>;
+using ExpertBoard = BasicBoard<StaticDims<30, 16>>;
+using ExpertHexBoard = BasicBoard<StaticDims<30, 16>, HexTopology>;
+using ExpertTriangleBoard = BasicBoard<StaticDims<30, 16>, TriangleTopology>;
+using ExpertTorusBoard = BasicBoard<StaticDims<30, 16>, TorusTopology>;
+#endif
@@ -0,0 +1,226 @@
+#include "BoardCache.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include "GLCounters.h"
+
+namespace
+{
+	//Must match res/shaders/tile/common.glsl
+	const float REVEAL_RIPPLE_DELAY = 0.015f;
+	const float REVEAL_DURATION = 0.2f;
+
+	//Uniform locations in res/shaders/tile/vertex.shader and res/shaders/overview/vertex.shader
+	const int TIME_UNIFORM_LOCATION = 0;
+	const int VIEW_PROJECTION_UNIFORM_LOCATION = 0;
+
+	//Chunk textures hold a power of two texels per cell at or above the zoom, within these bounds
+	const int MIN_TEXELS_PER_CELL = 4;
+	const int MAX_TEXELS_PER_CELL = 32;
+	//Targets of chunks not drawn for this many frames are freed
+	const uint64_t EVICT_AFTER_FRAMES = 120;
+
+	//Per vertex: position relative to the camera's origin cell, texture coordinate
+	const int FLOATS_PER_VERTEX = 4;
+}
+
+void BoardCache::Rect::Add(const Rect& other)
+{
+	x0 = std::min(x0, other.x0);
+	y0 = std::min(y0, other.y0);
+	x1 = std::max(x1, other.x1);
+	y1 = std::max(y1, other.y1);
+}
+
+BoardCache::BoardCache()
+	: m_Columns(0), m_Rows(0), m_TexelsPerCell(0), m_Frame(0), m_VBO(NULL, 0, GL_STREAM_DRAW)
+{
+	m_VAO.Bind();
+	const int stride = FLOATS_PER_VERTEX * sizeof(float);
+	m_VAO.LinkAttrib(m_VBO, 0, 2, GL_FLOAT, stride, (void*)0);
+	m_VAO.LinkAttrib(m_VBO, 1, 2, GL_FLOAT, stride, (void*)(2 * sizeof(float)));
+	m_VAO.Unbind();
+}
+
+uint64_t BoardCache::Key(const int chunkX, const int chunkY)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(chunkY)) << 32) | static_cast<uint32_t>(chunkX);
+}
+
+void BoardCache::Reset(const int columns, const int rows)
+{
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Chunks.clear();
+}
+
+void BoardCache::Invalidate(const std::vector<CellReveal>& reveals)
+{
+	for (const CellReveal& reveal : reveals)
+	{
+		if (m_Columns == 0)
+			break;
+
+		const int x = static_cast<int>(reveal.cell % m_Columns);
+		const int y = static_cast<int>(reveal.cell / m_Columns);
+		Chunk& chunk = m_Chunks[Key(x / CHUNK_CELLS, y / CHUNK_CELLS)];
+
+		Rect cell;
+		cell.x0 = x % CHUNK_CELLS;
+		cell.y0 = y % CHUNK_CELLS;
+		cell.x1 = cell.x0 + 1;
+		cell.y1 = cell.y0 + 1;
+		chunk.dirty.Add(cell);
+		chunk.animating.Add(cell);
+		chunk.animatingUntil = std::max(chunk.animatingUntil, reveal.time + reveal.distance * REVEAL_RIPPLE_DELAY + REVEAL_DURATION);
+	}
+}
+
+void BoardCache::InvalidateAll()
+{
+	for (auto& entry : m_Chunks)
+	{
+		entry.second.dirty.x0 = entry.second.dirty.y0 = 0;
+		entry.second.dirty.x1 = entry.second.dirty.y1 = CHUNK_CELLS;
+	}
+}
+
+void BoardCache::Render(BoardRenderer& board, const ShaderProgram& tileShader, const int chunkX, const int chunkY, Chunk& chunk)
+{
+	//Only the part of the chunk that is on the board
+	Rect& dirty = chunk.dirty;
+	dirty.x1 = std::min(dirty.x1, m_Columns - chunkX * CHUNK_CELLS);
+	dirty.y1 = std::min(dirty.y1, m_Rows - chunkY * CHUNK_CELLS);
+	if (dirty.IsEmpty())
+	{
+		dirty = Rect();
+		return;
+	}
+
+	chunk.target->Bind();
+
+	//Texture rows go bottom up, so the scissor is flipped relative to the board's rows
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(dirty.x0 * m_TexelsPerCell, (CHUNK_CELLS - dirty.y1) * m_TexelsPerCell,
+	          (dirty.x1 - dirty.x0) * m_TexelsPerCell, (dirty.y1 - dirty.y0) * m_TexelsPerCell);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	//The chunk's corner cell is the origin; it maps the chunk's cells onto the whole target, row 0 at the top
+	const glm::i64vec2 origin(static_cast<int64_t>(chunkX) * CHUNK_CELLS, static_cast<int64_t>(chunkY) * CHUNK_CELLS);
+	const glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(CHUNK_CELLS), static_cast<float>(CHUNK_CELLS), 0.0f);
+	board.DrawCells(tileShader, origin, projection, static_cast<int>(origin.x) + dirty.x0, static_cast<int>(origin.y) + dirty.y0,
+	                dirty.x1 - dirty.x0, dirty.y1 - dirty.y0);
+
+	glDisable(GL_SCISSOR_TEST);
+	dirty = Rect();
+}
+
+void BoardCache::Draw(BoardRenderer& board, const ShaderProgram& tileShader, const ShaderProgram& compositeShader, const Camera& camera, const float time)
+{
+	if (m_Columns == 0 || m_Rows == 0)
+		return;
+	m_Frame++;
+
+	//RESOLUTION follows the zoom in powers of two, so chunks are only redrawn on big zoom changes
+	int texelsPerCell = MIN_TEXELS_PER_CELL;
+	while (texelsPerCell < camera.Zoom() && texelsPerCell < MAX_TEXELS_PER_CELL)
+		texelsPerCell *= 2;
+	if (texelsPerCell != m_TexelsPerCell)
+	{
+		m_TexelsPerCell = texelsPerCell;
+		for (auto& entry : m_Chunks)
+			entry.second.target.reset();
+	}
+
+	//VISIBLE CHUNKS
+	const glm::dvec2 boardSize(m_Columns, m_Rows);
+	const glm::dvec2 topLeft = glm::clamp(camera.ScreenToCell(glm::dvec2(0.0)), glm::dvec2(0.0), boardSize);
+	const glm::dvec2 bottomRight = glm::clamp(camera.ScreenToCell(glm::dvec2(camera.ViewportWidth(), camera.ViewportHeight())), glm::dvec2(0.0), boardSize);
+	if (topLeft.x >= bottomRight.x || topLeft.y >= bottomRight.y)
+		return;
+	const int chunkX0 = static_cast<int>(topLeft.x) / CHUNK_CELLS;
+	const int chunkY0 = static_cast<int>(topLeft.y) / CHUNK_CELLS;
+	const int chunkX1 = (static_cast<int>(std::ceil(bottomRight.x)) + CHUNK_CELLS - 1) / CHUNK_CELLS;
+	const int chunkY1 = (static_cast<int>(std::ceil(bottomRight.y)) + CHUNK_CELLS - 1) / CHUNK_CELLS;
+
+	//UPDATE the dirty parts of the visible chunks
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	tileShader.Activate();
+	tileShader.Set1f(TIME_UNIFORM_LOCATION, time);
+
+	const glm::i64vec2 origin = camera.Rebase();
+	const glm::dvec2 originCell(static_cast<double>(origin.x), static_cast<double>(origin.y));
+	m_Vertices.clear();
+	std::vector<const FrameBufferObject*> targets;
+	for (int chunkY = chunkY0; chunkY < chunkY1; chunkY++)
+	{
+		for (int chunkX = chunkX0; chunkX < chunkX1; chunkX++)
+		{
+			Chunk& chunk = m_Chunks[Key(chunkX, chunkY)];
+			if (!chunk.target)
+			{
+				const int size = CHUNK_CELLS * m_TexelsPerCell;
+				chunk.target = std::make_unique<FrameBufferObject>(size, size);
+				chunk.dirty.x0 = chunk.dirty.y0 = 0;
+				chunk.dirty.x1 = chunk.dirty.y1 = CHUNK_CELLS;
+			}
+			chunk.lastDrawn = m_Frame;
+
+			//Animating cells are redrawn every frame, including once after they have finished
+			if (!chunk.animating.IsEmpty())
+			{
+				chunk.dirty.Add(chunk.animating);
+				if (time >= chunk.animatingUntil)
+					chunk.animating = Rect();
+			}
+			if (!chunk.dirty.IsEmpty())
+				Render(board, tileShader, chunkX, chunkY, chunk);
+
+			//COMPOSITE QUAD over the part of the chunk that is on the board
+			const glm::dvec2 corner(static_cast<double>(chunkX) * CHUNK_CELLS, static_cast<double>(chunkY) * CHUNK_CELLS);
+			const glm::dvec2 end = glm::min(corner + glm::dvec2(CHUNK_CELLS), boardSize);
+			const glm::dvec2 corners[4] = { corner, glm::dvec2(end.x, corner.y), glm::dvec2(corner.x, end.y), end };
+			for (const glm::dvec2& point : corners)
+			{
+				const glm::dvec2 position = point - originCell;
+				const glm::dvec2 inChunk = (point - corner) / static_cast<double>(CHUNK_CELLS);
+				m_Vertices.push_back(static_cast<float>(position.x));
+				m_Vertices.push_back(static_cast<float>(position.y));
+				m_Vertices.push_back(static_cast<float>(inChunk.x));
+				m_Vertices.push_back(static_cast<float>(1.0 - inChunk.y));
+			}
+			targets.push_back(chunk.target.get());
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+	//COMPOSITE, one streamed buffer for every quad and a draw per chunk texture
+	m_VBO.SetData(m_Vertices.data(), static_cast<unsigned int>(m_Vertices.size() * sizeof(float)), GL_STREAM_DRAW);
+	m_VBO.Unbind();
+	compositeShader.Activate();
+	compositeShader.SetMatrix4f(VIEW_PROJECTION_UNIFORM_LOCATION, camera.ViewProjection(origin));
+	glActiveTexture(GL_TEXTURE0);
+	m_VAO.Bind();
+	for (size_t i = 0; i < targets.size(); i++)
+	{
+		glBindTexture(GL_TEXTURE_2D, targets[i]->m_Texture);
+		glDrawArrays(GL_TRIANGLE_STRIP, static_cast<GLint>(i * 4), 4);
+		GLCounters::Current().drawCalls++;
+	}
+	m_VAO.Unbind();
+
+	//EVICT targets that have been off screen for a while; chunks still animating keep their entry
+	for (auto it = m_Chunks.begin(); it != m_Chunks.end();)
+	{
+		Chunk& chunk = it->second;
+		if (chunk.target && m_Frame - chunk.lastDrawn > EVICT_AFTER_FRAMES)
+			chunk.target.reset();
+		if (!chunk.target && (chunk.animating.IsEmpty() || time >= chunk.animatingUntil))
+			it = m_Chunks.erase(it);
+		else
+			++it;
+	}
+}
@@ -0,0 +1,69 @@
+#ifndef BOARD_CACHE_CLASS
+#define BOARD_CACHE_CLASS
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "BoardRenderer.h"
+#include "Camera.h"
+#include "CellReveal.h"
+#include "FrameBufferObject.h"
+#include "ShaderProgram.h"
+#include "VertexArrayObject.h"
+#include "VertexBufferObject.h"
+
+//Keeps the board rendered into one offscreen texture per CHUNK_CELLS x CHUNK_CELLS chunk and
+//composites those every frame. Only the cells reported changed are drawn again, into their chunk
+//with the scissor test limiting the pass to them, so a static board costs one textured quad per
+//visible chunk however busy the rest of the frame is.
+//
+//Cells still playing their reveal animation stay dirty until it has finished. The per-frame
+//pulse of the ANIMATED tile variant would dirty everything every frame, so cached chunks are
+//drawn with a variant without it.
+class BoardCache
+{
+public:
+	static const int CHUNK_CELLS = 64;
+private:
+	//Cells [x0, x1) x [y0, y1) relative to a chunk's corner
+	struct Rect
+	{
+		int x0 = CHUNK_CELLS, y0 = CHUNK_CELLS, x1 = 0, y1 = 0;
+		bool IsEmpty() const { return x0 >= x1 || y0 >= y1; }
+		void Add(const Rect& other);
+	};
+
+	struct Chunk
+	{
+		//Created when the chunk first becomes visible, dropped when it has not been for a while
+		std::unique_ptr<FrameBufferObject> target;
+		Rect dirty;
+		//Cells whose reveal animation is still playing, and the game time the last one ends
+		Rect animating;
+		float animatingUntil = 0.0f;
+		uint64_t lastDrawn = 0;
+	};
+
+	std::unordered_map<uint64_t, Chunk> m_Chunks;
+	int m_Columns;
+	int m_Rows;
+	int m_TexelsPerCell;
+	uint64_t m_Frame;
+
+	VertexArrayObject m_VAO;
+	VertexBufferObject m_VBO;
+	std::vector<float> m_Vertices;
+public:
+	BoardCache();
+	void Reset(int columns, int rows);
+	void Invalidate(const std::vector<CellReveal>& reveals);
+	//Everything has to be drawn again, e.g. after the tile variant changed
+	void InvalidateAll();
+	//Brings the visible chunks up to date with tileShader, then composites them with compositeShader.
+	//The tiles' texture must be bound.
+	void Draw(BoardRenderer& board, const ShaderProgram& tileShader, const ShaderProgram& compositeShader, const Camera& camera, float time);
+private:
+	static uint64_t Key(int chunkX, int chunkY);
+	void Render(BoardRenderer& board, const ShaderProgram& tileShader, int chunkX, int chunkY, Chunk& chunk);
+};
+#endif
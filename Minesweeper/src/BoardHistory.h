@@ -0,0 +1,57 @@
+#ifndef BOARD_HISTORY_CLASS
+#define BOARD_HISTORY_CLASS
+#include <cstddef>
+#include <vector>
+#include "CellReveal.h"
+
+//Unlimited undo, redo and scrubbing for one game on a BasicBoard. Every entry is a Snapshot of the
+//board after a move; consecutive snapshots share all the blocks the move between them did not
+//touch, so the history grows with what the moves changed. Moving through it restores only the
+//blocks that differ between where the board is and where it goes.
+template <typename BoardType>
+class BoardHistory
+{
+private:
+	using Snapshot = typename BoardType::Snapshot;
+
+	std::vector<Snapshot> m_Entries;
+	//Entry the board is at
+	size_t m_Cursor;
+public:
+	BoardHistory()
+		: m_Cursor(0)
+	{
+	}
+
+	//Forgets everything; the board as it is now, e.g. right after Reset, becomes the only entry
+	void Reset(BoardType& board)
+	{
+		m_Entries.clear();
+		m_Entries.push_back(board.Capture(nullptr));
+		m_Cursor = 0;
+	}
+
+	//Adds the board as it is after a move. Whatever was undone past the cursor is dropped.
+	void Record(BoardType& board)
+	{
+		m_Entries.resize(m_Cursor + 1);
+		m_Entries.push_back(board.Capture(&m_Entries[m_Cursor]));
+		m_Cursor++;
+	}
+
+	//Each appends the cells that open or close to changes and returns false when there is nowhere to go
+	bool Undo(BoardType& board, const float time, std::vector<CellReveal>& changes) { return m_Cursor > 0 && Seek(board, m_Cursor - 1, time, changes); }
+	bool Redo(BoardType& board, const float time, std::vector<CellReveal>& changes) { return Seek(board, m_Cursor + 1, time, changes); }
+	bool Seek(BoardType& board, const size_t entry, const float time, std::vector<CellReveal>& changes)
+	{
+		if (entry >= m_Entries.size() || entry == m_Cursor)
+			return false;
+		board.Restore(m_Entries[entry], m_Entries[m_Cursor], time, changes);
+		m_Cursor = entry;
+		return true;
+	}
+
+	size_t Entries() const { return m_Entries.size(); }
+	size_t Cursor() const { return m_Cursor; }
+};
+#endif
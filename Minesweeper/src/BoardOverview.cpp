@@ -0,0 +1,242 @@
+#include "BoardOverview.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "GLCounters.h"
+
+namespace
+{
+	//Location of the viewProjection uniform in res/shaders/overview/vertex.shader
+	const int VIEW_PROJECTION_UNIFORM_LOCATION = 0;
+	//Per vertex: position relative to the origin cell, texture coordinate
+	const int FLOATS_PER_VERTEX = 4;
+}
+
+BoardOverview::BoardOverview()
+	: m_Texture(0), m_VBO(NULL, 4 * FLOATS_PER_VERTEX * sizeof(float), GL_STREAM_DRAW),
+	  m_Columns(0), m_Rows(0), m_BaseShift(0),
+	  m_DirtyX0(INT_MAX), m_DirtyY0(INT_MAX), m_DirtyX1(0), m_DirtyY1(0)
+{
+	m_VAO.Bind();
+	const int stride = FLOATS_PER_VERTEX * sizeof(float);
+	m_VAO.LinkAttrib(m_VBO, 0, 2, GL_FLOAT, stride, (void*)0);
+	m_VAO.LinkAttrib(m_VBO, 1, 2, GL_FLOAT, stride, (void*)(2 * sizeof(float)));
+	m_VAO.Unbind();
+}
+
+BoardOverview::~BoardOverview()
+{
+	glDeleteTextures(1, &m_Texture);
+}
+
+void BoardOverview::Reset(const int columns, const int rows)
+{
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Cells.assign(static_cast<size_t>(columns) * rows, 0);
+
+	int maxTextureSize;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+	m_BaseShift = 0;
+	while (((columns - 1) >> m_BaseShift) + 1 > maxTextureSize || ((rows - 1) >> m_BaseShift) + 1 > maxTextureSize)
+		m_BaseShift++;
+
+	//LEVELS down to 1x1
+	m_Levels.clear();
+	m_LevelWidths.clear();
+	m_LevelHeights.clear();
+	int width = std::max(((columns - 1) >> m_BaseShift) + 1, 1);
+	int height = std::max(((rows - 1) >> m_BaseShift) + 1, 1);
+	while (true)
+	{
+		m_Levels.emplace_back(static_cast<size_t>(width) * height, Texel{ 0, 0, 0, 0 });
+		m_LevelWidths.push_back(width);
+		m_LevelHeights.push_back(height);
+		if (width == 1 && height == 1)
+			break;
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+
+	//TEXTURE, immutable storage for the whole chain
+	glDeleteTextures(1, &m_Texture);
+	glGenTextures(1, &m_Texture);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(m_Levels.size()), GL_RGBA8, m_LevelWidths[0], m_LevelHeights[0]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	//Everything starts hidden, which is all zeroes
+	m_DirtyX0 = 0;
+	m_DirtyY0 = 0;
+	m_DirtyX1 = columns;
+	m_DirtyY1 = rows;
+}
+
+void BoardOverview::SetCell(const uint32_t cell, const uint8_t state)
+{
+	if (cell >= m_Cells.size() || m_Cells[cell] == state)
+		return;
+
+	m_Cells[cell] = state;
+	const int x = static_cast<int>(cell % m_Columns);
+	const int y = static_cast<int>(cell / m_Columns);
+	m_DirtyX0 = std::min(m_DirtyX0, x);
+	m_DirtyY0 = std::min(m_DirtyY0, y);
+	m_DirtyX1 = std::max(m_DirtyX1, x + 1);
+	m_DirtyY1 = std::max(m_DirtyY1, y + 1);
+}
+
+void BoardOverview::Aggregate(const int level, const int x0, const int y0, const int x1, const int y1)
+{
+	std::vector<Texel>& texels = m_Levels[level];
+	const int width = m_LevelWidths[level];
+	for (int y = y0; y < y1; y++)
+	{
+		for (int x = x0; x < x1; x++)
+		{
+			//Sum the cells (base level) or the texels of the level below that this texel covers
+			unsigned int revealed = 0, flagged = 0, exploded = 0, count = 0;
+			if (level == 0)
+			{
+				const int cellX1 = std::min((x + 1) << m_BaseShift, m_Columns);
+				const int cellY1 = std::min((y + 1) << m_BaseShift, m_Rows);
+				for (int cy = y << m_BaseShift; cy < cellY1; cy++)
+				{
+					for (int cx = x << m_BaseShift; cx < cellX1; cx++)
+					{
+						const uint8_t state = m_Cells[static_cast<size_t>(cy) * m_Columns + cx];
+						revealed += (state & REVEALED) ? 255 : 0;
+						flagged += (state & FLAGGED) ? 255 : 0;
+						exploded += (state & EXPLODED) ? 255 : 0;
+						count++;
+					}
+				}
+			}
+			else
+			{
+				//An odd sized level folds its last row/column into the texel before it
+				const std::vector<Texel>& below = m_Levels[level - 1];
+				const int belowWidth = m_LevelWidths[level - 1];
+				const int belowHeight = m_LevelHeights[level - 1];
+				const int childX1 = (x == width - 1) ? belowWidth : std::min(2 * x + 2, belowWidth);
+				const int childY1 = (y == m_LevelHeights[level] - 1) ? belowHeight : std::min(2 * y + 2, belowHeight);
+				for (int cy = 2 * y; cy < childY1; cy++)
+				{
+					for (int cx = 2 * x; cx < childX1; cx++)
+					{
+						const Texel& child = below[static_cast<size_t>(cy) * belowWidth + cx];
+						revealed += child.revealed;
+						flagged += child.flagged;
+						exploded += child.exploded;
+						count++;
+					}
+				}
+			}
+
+			if (count == 0)
+				continue;
+			Texel& texel = texels[static_cast<size_t>(y) * width + x];
+			texel.revealed = static_cast<uint8_t>(revealed / count);
+			texel.flagged = static_cast<uint8_t>(flagged / count);
+			//Rounded up so a single exploded mine never averages away to nothing
+			texel.exploded = static_cast<uint8_t>((exploded + count - 1) / count);
+		}
+	}
+}
+
+void BoardOverview::Upload()
+{
+	if (m_DirtyX0 >= m_DirtyX1 || m_DirtyY0 >= m_DirtyY1)
+		return;
+
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+
+	//Dirty cells in texels of the current level
+	int x0 = m_DirtyX0 >> m_BaseShift;
+	int y0 = m_DirtyY0 >> m_BaseShift;
+	int x1 = ((m_DirtyX1 - 1) >> m_BaseShift) + 1;
+	int y1 = ((m_DirtyY1 - 1) >> m_BaseShift) + 1;
+	for (size_t level = 0; level < m_Levels.size(); level++)
+	{
+		const int width = m_LevelWidths[level];
+		const int height = m_LevelHeights[level];
+		if (level > 0)
+		{
+			//Parents of the dirty texels below; the last row/column may also own a folded odd one
+			x0 = std::min(x0 / 2, width - 1);
+			y0 = std::min(y0 / 2, height - 1);
+			x1 = std::min((x1 + 1) / 2, width);
+			y1 = std::min((y1 + 1) / 2, height);
+		}
+		x1 = std::max(x1, x0 + 1);
+		y1 = std::max(y1, y0 + 1);
+
+		Aggregate(static_cast<int>(level), x0, y0, x1, y1);
+
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+		glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), x0, y0, x1 - x0, y1 - y0, GL_RGBA, GL_UNSIGNED_BYTE,
+		                m_Levels[level].data() + static_cast<size_t>(y0) * width + x0);
+		GLCounters::Current().uploadBytes += static_cast<uint64_t>(x1 - x0) * (y1 - y0) * sizeof(Texel);
+	}
+
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	m_DirtyX0 = m_DirtyY0 = INT_MAX;
+	m_DirtyX1 = m_DirtyY1 = 0;
+}
+
+void BoardOverview::Draw(const ShaderProgram& shader, const Camera& camera)
+{
+	if (m_Cells.empty())
+		return;
+
+	Upload();
+
+	//Only the visible part of the board, so the corners stay close to the origin cell and keep
+	//their precision even on boards far larger than a float can count
+	const glm::dvec2 board(m_Columns, m_Rows);
+	const glm::dvec2 topLeft = glm::clamp(camera.ScreenToCell(glm::dvec2(0.0)), glm::dvec2(0.0), board);
+	const glm::dvec2 bottomRight = glm::clamp(camera.ScreenToCell(glm::dvec2(camera.ViewportWidth(), camera.ViewportHeight())), glm::dvec2(0.0), board);
+	if (topLeft.x >= bottomRight.x || topLeft.y >= bottomRight.y)
+		return;
+
+	const glm::i64vec2 origin = camera.Rebase();
+	const glm::dvec2 originCell(static_cast<double>(origin.x), static_cast<double>(origin.y));
+	//Texture coordinates over the cells the base level covers, which can be a few more than the board
+	const glm::dvec2 textureCells(static_cast<double>(m_LevelWidths[0]) * (1 << m_BaseShift), static_cast<double>(m_LevelHeights[0]) * (1 << m_BaseShift));
+
+	const glm::dvec2 corners[4] =
+	{
+		topLeft,
+		glm::dvec2(bottomRight.x, topLeft.y),
+		glm::dvec2(topLeft.x, bottomRight.y),
+		bottomRight
+	};
+	float vertices[4 * FLOATS_PER_VERTEX];
+	for (int i = 0; i < 4; i++)
+	{
+		const glm::dvec2 position = corners[i] - originCell;
+		const glm::dvec2 texCoord = corners[i] / textureCells;
+		vertices[i * FLOATS_PER_VERTEX + 0] = static_cast<float>(position.x);
+		vertices[i * FLOATS_PER_VERTEX + 1] = static_cast<float>(position.y);
+		vertices[i * FLOATS_PER_VERTEX + 2] = static_cast<float>(texCoord.x);
+		vertices[i * FLOATS_PER_VERTEX + 3] = static_cast<float>(texCoord.y);
+	}
+	m_VBO.SetData(vertices, sizeof(vertices), GL_STREAM_DRAW);
+	m_VBO.Unbind();
+
+	shader.SetMatrix4f(VIEW_PROJECTION_UNIFORM_LOCATION, camera.ViewProjection(origin));
+
+	//overview is bound to unit 0 in the shader itself
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	m_VAO.Bind();
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	GLCounters::Current().drawCalls++;
+	m_VAO.Unbind();
+}
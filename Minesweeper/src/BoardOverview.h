@@ -0,0 +1,63 @@
+#ifndef BOARD_OVERVIEW_CLASS
+#define BOARD_OVERVIEW_CLASS
+#include <cstdint>
+#include <vector>
+#include "Camera.h"
+#include "ShaderProgram.h"
+#include "VertexArrayObject.h"
+#include "VertexBufferObject.h"
+
+//Mip pyramid of aggregated cell state for drawing the board zoomed out. Each RGBA8 texel holds
+//the revealed fraction, flag density and exploded mine fraction of the cells it covers, so one
+//quad sampled with trilinear filtering draws the whole board at a cost bounded by the screen,
+//not the board, and without the aliasing of drawing sub-pixel tiles.
+//
+//Changes only touch the cells' parents: a dirty rectangle is recomputed level by level on the
+//CPU and uploaded with one glTexSubImage2D per level.
+class BoardOverview
+{
+public:
+	enum CellState : uint8_t
+	{
+		REVEALED = 1 << 0,
+		FLAGGED = 1 << 1,
+		EXPLODED = 1 << 2
+	};
+private:
+	struct Texel
+	{
+		uint8_t revealed;
+		uint8_t flagged;
+		uint8_t exploded;
+		uint8_t unused;
+	};
+
+	unsigned int m_Texture;
+	VertexArrayObject m_VAO;
+	VertexBufferObject m_VBO;
+
+	int m_Columns;
+	int m_Rows;
+	std::vector<uint8_t> m_Cells;
+	//Boards larger than the biggest texture the driver supports start at a coarser level:
+	//each base texel covers 2^m_BaseShift cells per side
+	int m_BaseShift;
+	//CPU copy of every mip level, level 0 first
+	std::vector<std::vector<Texel>> m_Levels;
+	std::vector<int> m_LevelWidths;
+	std::vector<int> m_LevelHeights;
+	//Changed cells since the last upload, [begin, end)
+	int m_DirtyX0, m_DirtyY0, m_DirtyX1, m_DirtyY1;
+public:
+	BoardOverview();
+	~BoardOverview();
+	void Reset(int columns, int rows);
+	void SetCell(uint32_t cell, uint8_t state);
+	//Draws the visible part of the board as one quad. The shader must be active.
+	void Draw(const ShaderProgram& shader, const Camera& camera);
+private:
+	void Upload();
+	//Recomputes the texels of level that cover cells [x0, x1) x [y0, y1)
+	void Aggregate(int level, int x0, int y0, int x1, int y1);
+};
+#endif
@@ -0,0 +1,250 @@
+#include "BoardRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include "GLCounters.h"
+
+namespace
+{
+	//DATA
+	const float vertices[] =
+	{
+		//COORDINATES       |     COLOR           | TEX COORD
+		-0.5f,  -0.5f,  0.0f,  1.0f, 0.0f, 0.0f,   0.0f, 0.0f,        //bottom - left
+		 0.5f,  -0.5f,  0.0f,  0.0f, 1.0f, 0.0f,   1.0f, 0.0f,        //bottom - right
+		-0.5f,   0.5f,  0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 1.0f,        //top - left
+		 0.5f,   0.5f,  0.0f,  1.0f, 0.0f, 0.0f,   1.0f, 1.0f         //top - right
+	};
+
+	const unsigned int indices[] =
+	{
+		0, 1, 2,
+		1, 2, 3
+	};
+
+	//Pointy-top hexagon one unit wide, as a fan of four triangles
+	const float hexVertices[] =
+	{
+		//COORDINATES         |     COLOR           | TEX COORD
+		 0.0f,  -0.57735f, 0.0f,  1.0f, 0.0f, 0.0f,   0.5f, 0.0f,         //top
+		 0.5f,  -0.28868f, 0.0f,  0.0f, 1.0f, 0.0f,   1.0f, 0.25f,        //top - right
+		 0.5f,   0.28868f, 0.0f,  0.0f, 0.0f, 1.0f,   1.0f, 0.75f,        //bottom - right
+		 0.0f,   0.57735f, 0.0f,  1.0f, 0.0f, 0.0f,   0.5f, 1.0f,         //bottom
+		-0.5f,   0.28868f, 0.0f,  0.0f, 1.0f, 0.0f,   0.0f, 0.75f,        //bottom - left
+		-0.5f,  -0.28868f, 0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 0.25f         //top - left
+	};
+
+	const unsigned int hexIndices[] =
+	{
+		0, 1, 2,
+		0, 2, 3,
+		0, 3, 4,
+		0, 4, 5
+	};
+
+	//Triangle one unit wide pointing up; the shader mirrors every other one
+	const float triangleVertices[] =
+	{
+		//COORDINATES         |     COLOR           | TEX COORD
+		 0.0f,  -0.43301f, 0.0f,  1.0f, 0.0f, 0.0f,   0.5f, 0.0f,         //top
+		 0.5f,   0.43301f, 0.0f,  0.0f, 1.0f, 0.0f,   1.0f, 1.0f,         //bottom - right
+		-0.5f,   0.43301f, 0.0f,  0.0f, 0.0f, 1.0f,   0.0f, 1.0f          //bottom - left
+	};
+
+	const unsigned int triangleIndices[] =
+	{
+		0, 1, 2
+	};
+
+	//Uniform locations in res/shaders/tile/vertex.shader
+	const int BOARD_SIZE_UNIFORM_LOCATION = 1;
+	const int CELL_ORIGIN_UNIFORM_LOCATION = 2;
+	const int VIEW_PROJECTION_UNIFORM_LOCATION = 3;
+	const int FIRST_CELL_UNIFORM_LOCATION = 4;
+	const int CELL_LAYOUT_UNIFORM_LOCATION = 5;
+	const int ALTERNATE_UNIFORM_LOCATION = 6;
+	const int CELL_OFFSET_UNIFORM_LOCATION = 7;
+	//Attribute location of the per instance reveal data
+	const unsigned int REVEAL_ATTRIBUTE = 3;
+	const float HIDDEN = -1.0f;
+}
+
+BoardRenderer::BoardRenderer()
+	: m_QuadVBO(vertices, sizeof(vertices)),
+	  m_QuadIBO(indices, sizeof(indices)),
+	  m_InstanceVBO(NULL, 0, GL_DYNAMIC_DRAW),
+	  m_Topology(GridTopology::SQUARE), m_IndexCount(sizeof(indices) / sizeof(indices[0])),
+	  m_Columns(0), m_Rows(0), m_Origin(0), m_DirtyBegin(0), m_DirtyEnd(0)
+{
+	//VAO GENERATION
+	m_VAO.Bind();
+	m_QuadIBO.Bind();
+
+	//COORDS
+	const int numCoords = 3;
+	const int numColors = 3;
+	const int numTextCoords = 2;
+	const int stride = (numCoords + numColors + numTextCoords) * sizeof(float);
+
+	m_VAO.LinkAttrib(m_QuadVBO, 0, numCoords, GL_FLOAT, stride, (void*)0);
+	m_VAO.LinkAttrib(m_QuadVBO, 1, numColors, GL_FLOAT, stride, (void*)(numCoords * sizeof(float)));
+	m_VAO.LinkAttrib(m_QuadVBO, 2, numTextCoords, GL_FLOAT, stride, (void*)((numCoords + numColors) * sizeof(float)));
+
+	//INSTANCES
+	m_VAO.LinkInstanceAttrib(m_InstanceVBO, REVEAL_ATTRIBUTE, 3, GL_FLOAT, sizeof(Instance), (void*)0);
+
+	m_VAO.Unbind();
+	m_QuadIBO.Unbind();
+}
+
+void BoardRenderer::Reset(const int columns, const int rows, const GridTopology::Kind topology, const glm::i64vec2 origin)
+{
+	if (topology != m_Topology)
+		SetMesh(topology);
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Origin = origin;
+	m_Instances.assign(static_cast<size_t>(columns) * rows, Instance{ HIDDEN, 0.0f, 0.0f });
+
+	//Orphans the old storage, so a frame still drawing from it is never waited on
+	m_InstanceVBO.SetData(m_Instances.data(), static_cast<unsigned int>(m_Instances.size() * sizeof(Instance)), GL_DYNAMIC_DRAW);
+	m_InstanceVBO.Unbind();
+	m_DirtyBegin = m_DirtyEnd = 0;
+
+	m_Overview.Reset(columns, rows);
+}
+
+//The tile mesh goes into the same VBO and IBO as the square's, so the VAO and the draws stay the same
+void BoardRenderer::SetMesh(const GridTopology::Kind topology)
+{
+	m_Topology = topology;
+	const float* meshVertices = vertices;
+	unsigned int vertexBytes = sizeof(vertices);
+	const unsigned int* meshIndices = indices;
+	unsigned int indexBytes = sizeof(indices);
+	if (topology == GridTopology::HEX)
+	{
+		meshVertices = hexVertices;
+		vertexBytes = sizeof(hexVertices);
+		meshIndices = hexIndices;
+		indexBytes = sizeof(hexIndices);
+	}
+	else if (topology == GridTopology::TRIANGLE)
+	{
+		meshVertices = triangleVertices;
+		vertexBytes = sizeof(triangleVertices);
+		meshIndices = triangleIndices;
+		indexBytes = sizeof(triangleIndices);
+	}
+	m_IndexCount = static_cast<int>(indexBytes / sizeof(unsigned int));
+
+	m_VAO.Bind();
+	m_QuadVBO.SetData(meshVertices, vertexBytes, GL_STATIC_DRAW);
+	m_QuadIBO.SetData(meshIndices, indexBytes);
+	m_VAO.Unbind();
+	m_QuadVBO.Unbind();
+}
+
+void BoardRenderer::Reveal(const std::vector<CellReveal>& reveals)
+{
+	for (const CellReveal& reveal : reveals)
+	{
+		if (reveal.cell >= m_Instances.size())
+			continue;
+
+		m_Instances[reveal.cell] = Instance{ reveal.time, reveal.distance, static_cast<float>(reveal.face) };
+		uint8_t overview = 0;
+		if (reveal.time >= 0.0f)
+			overview = reveal.face == CellReveal::MINE ? BoardOverview::REVEALED | BoardOverview::EXPLODED : BoardOverview::REVEALED;
+		else if (reveal.face == CellReveal::FLAG)
+			overview = BoardOverview::FLAGGED;
+		m_Overview.SetCell(reveal.cell, overview);
+		if (m_DirtyBegin >= m_DirtyEnd)
+		{
+			m_DirtyBegin = reveal.cell;
+			m_DirtyEnd = reveal.cell + 1;
+		}
+		else
+		{
+			m_DirtyBegin = std::min<size_t>(m_DirtyBegin, reveal.cell);
+			m_DirtyEnd = std::max<size_t>(m_DirtyEnd, reveal.cell + 1);
+		}
+	}
+}
+
+void BoardRenderer::Upload()
+{
+	if (m_DirtyBegin >= m_DirtyEnd)
+		return;
+
+	//One contiguous range per frame; a flood fill opens cells that are close together anyway
+	m_InstanceVBO.SubData(static_cast<unsigned int>(m_DirtyBegin * sizeof(Instance)),
+	                      static_cast<unsigned int>((m_DirtyEnd - m_DirtyBegin) * sizeof(Instance)),
+	                      m_Instances.data() + m_DirtyBegin);
+	m_InstanceVBO.Unbind();
+	m_DirtyBegin = m_DirtyEnd = 0;
+}
+
+void BoardRenderer::Draw(const ShaderProgram& shader, const Camera& camera)
+{
+	//Cells are positioned relative to an origin near the view in integers, so they stay exact however far out the camera is
+	const glm::i64vec2 origin = camera.Rebase();
+
+	//VISIBLE CELLS: the viewport's corners divided by the layout's steps, widened by a cell where
+	//cells reach into the next column or row, then clamped to the board
+	const GridTopology::Layout& layout = LayoutOf(m_Topology);
+	const glm::dvec2 step(layout.columnStep, layout.rowStep);
+	const glm::dvec2 topLeft = camera.ScreenToCell(glm::dvec2(0.0)) / step;
+	const glm::dvec2 bottomRight = camera.ScreenToCell(glm::dvec2(camera.ViewportWidth(), camera.ViewportHeight())) / step;
+	const double margin = m_Topology == GridTopology::HEX || m_Topology == GridTopology::TRIANGLE ? 1.0 : 0.0;
+	const int column0 = static_cast<int>(std::clamp(std::floor(topLeft.x) - margin, 0.0, static_cast<double>(m_Columns)));
+	const int row0 = static_cast<int>(std::clamp(std::floor(topLeft.y) - margin, 0.0, static_cast<double>(m_Rows)));
+	const int column1 = static_cast<int>(std::clamp(std::ceil(bottomRight.x) + margin, 0.0, static_cast<double>(m_Columns)));
+	const int row1 = static_cast<int>(std::clamp(std::ceil(bottomRight.y) + margin, 0.0, static_cast<double>(m_Rows)));
+	DrawCells(shader, origin, camera.ViewProjection(origin), column0, row0, column1 - column0, row1 - row0);
+}
+
+void BoardRenderer::DrawCells(const ShaderProgram& shader, const glm::i64vec2 origin, const glm::mat4& viewProjection,
+                              const int column, const int row, const int width, const int height)
+{
+	if (m_Instances.empty() || width <= 0 || height <= 0)
+		return;
+
+	Upload();
+
+	//The cell at the world origin, kept on the board so cell - cellOrigin stays small, and how far it
+	//is from the origin in world units. Only that remainder reaches float.
+	const GridTopology::Layout& layout = LayoutOf(m_Topology);
+	const glm::dvec2 step(layout.columnStep, layout.rowStep);
+	const glm::dvec2 world(static_cast<double>(origin.x), static_cast<double>(origin.y));
+	const glm::dvec2 nearest = glm::clamp(glm::round(world / step), glm::dvec2(0.0), glm::dvec2(m_Columns, m_Rows));
+	const glm::dvec2 offset = nearest * step - world;
+
+	shader.Set2i(BOARD_SIZE_UNIFORM_LOCATION, m_Columns, m_Rows);
+	shader.Set2i(CELL_ORIGIN_UNIFORM_LOCATION, static_cast<int>(nearest.x), static_cast<int>(nearest.y));
+	shader.Set2f(CELL_OFFSET_UNIFORM_LOCATION, static_cast<float>(offset.x), static_cast<float>(offset.y));
+	shader.SetMatrix4f(VIEW_PROJECTION_UNIFORM_LOCATION, viewProjection);
+	shader.Set4f(CELL_LAYOUT_UNIFORM_LOCATION, static_cast<float>(layout.columnStep), static_cast<float>(layout.rowStep),
+	             static_cast<float>(layout.oddRowShift), static_cast<float>(layout.cellHeight * 0.5));
+	shader.Set1i(ALTERNATE_UNIFORM_LOCATION, layout.alternate ? 1 : 0);
+	m_VAO.Bind();
+
+	//Cells are contiguous in the instance buffer only along a row, or for whole rows. The base
+	//instance offsets the attributes and firstCell tells the shader which cell gl_InstanceID 0 is.
+	const bool wholeRows = column == 0 && width == m_Columns;
+	for (int y = row; y < row + height; y += wholeRows ? height : 1)
+	{
+		const GLuint firstCell = static_cast<GLuint>(y) * m_Columns + column;
+		shader.Set1i(FIRST_CELL_UNIFORM_LOCATION, static_cast<int>(firstCell));
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, 0, wholeRows ? width * height : width, firstCell);
+		GLCounters::Current().drawCalls++;
+	}
+
+	m_VAO.Unbind();
+}
+
+void BoardRenderer::DrawOverview(const ShaderProgram& shader, const Camera& camera)
+{
+	//Reveals still have to land in the instance buffer for when the camera zooms back in
+	Upload();
+	m_Overview.Draw(shader, camera);
+}
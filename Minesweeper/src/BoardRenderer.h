@@ -0,0 +1,69 @@
+#ifndef BOARD_RENDERER_CLASS
+#define BOARD_RENDERER_CLASS
+#include <vector>
+#include "BoardOverview.h"
+#include "Camera.h"
+#include "CellReveal.h"
+#include "IndexBufferObject.h"
+#include "ShaderProgram.h"
+#include "Topology.h"
+#include "VertexArrayObject.h"
+#include "VertexBufferObject.h"
+
+//Draws every cell of the board with one instanced draw of the tile quad. Per instance only the
+//reveal time, distance and face are stored, so animating any number of cells costs one uniform
+//per frame and a reveal uploads just the cells it changed. Hex and triangle boards swap the quad for
+//their own tile mesh and the shader places cells by the topology's layout.
+class BoardRenderer
+{
+private:
+	//Per instance: x = reveal time (negative while hidden), y = distance from the click,
+	//z = CellReveal face, drawn by the fragment shader
+	struct Instance
+	{
+		float revealTime;
+		float distance;
+		float face;
+	};
+
+	VertexArrayObject m_VAO;
+	VertexBufferObject m_QuadVBO;
+	IndexBufferObject m_QuadIBO;
+	VertexBufferObject m_InstanceVBO;
+	BoardOverview m_Overview;
+	GridTopology::Kind m_Topology;
+	//Of the current tile mesh
+	int m_IndexCount;
+
+	int m_Columns;
+	int m_Rows;
+	//World cell of the board's cell (0, 0); the endless window moves around the world with the camera
+	glm::i64vec2 m_Origin;
+	//CPU copy of the instance buffer
+	std::vector<Instance> m_Instances;
+	//Range of m_Instances changed since the last Upload, empty when m_DirtyBegin >= m_DirtyEnd
+	size_t m_DirtyBegin;
+	size_t m_DirtyEnd;
+public:
+	BoardRenderer();
+	//Starts a new board with every cell hidden, its cell (0, 0) at world cell origin
+	void Reset(int columns, int rows, GridTopology::Kind topology = GridTopology::SQUARE, glm::i64vec2 origin = glm::i64vec2(0));
+	void Reveal(const std::vector<CellReveal>& reveals);
+	//Draws the cells in view. The shader must be active; uploads pending reveals first.
+	void Draw(const ShaderProgram& shader, const Camera& camera);
+	//Draws a rectangle of cells with positions relative to the integer world point origin, which
+	//viewProjection was made for, e.g. into a cached chunk.
+	//One draw per row unless the rectangle spans whole rows.
+	void DrawCells(const ShaderProgram& shader, glm::i64vec2 origin, const glm::mat4& viewProjection, int column, int row, int width, int height);
+	int Columns() const { return m_Columns; }
+	int Rows() const { return m_Rows; }
+	glm::i64vec2 Origin() const { return m_Origin; }
+	GridTopology::Kind Topology() const { return m_Topology; }
+	//Draws from the overview pyramid instead of the tiles, for when cells are smaller than a pixel.
+	//The shader must be the active overview program.
+	void DrawOverview(const ShaderProgram& shader, const Camera& camera);
+private:
+	void SetMesh(GridTopology::Kind topology);
+	void Upload();
+};
+#endif
@@ -0,0 +1,98 @@
+#include "Camera.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+Camera::Camera()
+	: m_Center(0.0), m_Zoom(32.0), m_TargetZoom(32.0), m_ZoomAnchor(0.0), m_ViewportWidth(1), m_ViewportHeight(1)
+{
+}
+
+void Camera::SetViewport(const int width, const int height)
+{
+	m_ViewportWidth = std::max(width, 1);
+	m_ViewportHeight = std::max(height, 1);
+}
+
+void Camera::Fit(const double width, const double height)
+{
+	m_Center = glm::dvec2(width, height) * 0.5;
+	const double zoom = std::min(m_ViewportWidth / std::max(width, 1.0), m_ViewportHeight / std::max(height, 1.0));
+	m_Zoom = m_TargetZoom = std::clamp(zoom, MIN_ZOOM, MAX_ZOOM);
+}
+
+void Camera::CenterOn(const glm::dvec2 cell)
+{
+	m_Center = cell;
+}
+
+void Camera::Pan(const double dx, const double dy)
+{
+	m_Center -= glm::dvec2(dx, dy) / m_Zoom;
+}
+
+void Camera::ZoomAt(const glm::dvec2 screen, const double factor)
+{
+	m_TargetZoom = std::clamp(m_TargetZoom * factor, MIN_ZOOM, MAX_ZOOM);
+	m_ZoomAnchor = screen;
+}
+
+void Camera::Update(const double dt)
+{
+	if (m_Zoom == m_TargetZoom)
+		return;
+
+	//Ease in log space so every doubling takes as long, and snap once it is visually there
+	const glm::dvec2 anchorCell = ScreenToCell(m_ZoomAnchor);
+	const double remaining = std::log(m_TargetZoom / m_Zoom) * std::exp(-ZOOM_SPEED * dt);
+	m_Zoom = std::abs(remaining) < 1e-4 ? m_TargetZoom : m_TargetZoom / std::exp(remaining);
+
+	//Put the anchored cell back under the anchor point
+	m_Center += anchorCell - ScreenToCell(m_ZoomAnchor);
+}
+
+glm::dvec2 Camera::ScreenToCell(const glm::dvec2 screen) const
+{
+	const glm::dvec2 halfViewport = glm::dvec2(m_ViewportWidth, m_ViewportHeight) * 0.5;
+	return m_Center + (screen - halfViewport) / m_Zoom;
+}
+
+glm::dvec2 Camera::CellToScreen(const glm::dvec2 cell) const
+{
+	const glm::dvec2 halfViewport = glm::dvec2(m_ViewportWidth, m_ViewportHeight) * 0.5;
+	return (cell - m_Center) * m_Zoom + halfViewport;
+}
+
+Camera Camera::Relative(const glm::i64vec2 origin) const
+{
+	Camera result = *this;
+	result.m_Center -= glm::dvec2(static_cast<double>(origin.x), static_cast<double>(origin.y));
+	return result;
+}
+
+glm::i64vec2 Camera::Rebase() const
+{
+	return glm::i64vec2(static_cast<int64_t>(std::floor(m_Center.x)), static_cast<int64_t>(std::floor(m_Center.y)));
+}
+
+glm::mat4 Camera::ViewProjection(const glm::i64vec2 origin) const
+{
+	//Where the origin cell's corner lands on screen, worked out in double and rounded to a whole
+	//pixel. Only this small offset and the zoom reach float precision.
+	const glm::dvec2 corner = CellToScreen(glm::dvec2(static_cast<double>(origin.x), static_cast<double>(origin.y)));
+	const glm::vec2 snapped(static_cast<float>(std::round(corner.x)), static_cast<float>(std::round(corner.y)));
+
+	//Pixel space with y going down, like rows on the board and cursor positions
+	const glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(m_ViewportWidth), static_cast<float>(m_ViewportHeight), 0.0f);
+	glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(snapped, 0.0f));
+	view = glm::scale(view, glm::vec3(static_cast<float>(m_Zoom), static_cast<float>(m_Zoom), 1.0f));
+	return projection * view;
+}
+
+Camera Camera::Interpolate(const Camera& from, const Camera& to, const double alpha)
+{
+	Camera result = to;
+	result.m_Center = from.m_Center + (to.m_Center - from.m_Center) * alpha;
+	result.m_Zoom = from.m_Zoom * std::pow(to.m_Zoom / from.m_Zoom, alpha);
+	return result;
+}
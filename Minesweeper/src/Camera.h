@@ -0,0 +1,62 @@
+#ifndef CAMERA_CLASS
+#define CAMERA_CLASS
+#include <cstdint>
+#include <glm/glm.hpp>
+
+//2D orthographic camera over the board, in framebuffer pixels. The position is kept in double
+//precision cell coordinates so it stays exact far beyond the 2^24 cells a float can address;
+//the GPU only ever sees positions relative to an integer origin cell near the view (Rebase).
+class Camera
+{
+private:
+	//Cell coordinate at the center of the viewport
+	glm::dvec2 m_Center;
+	//Pixels per cell
+	double m_Zoom;
+	//Zoom that m_Zoom eases towards, keeping m_ZoomAnchor at the same screen position
+	double m_TargetZoom;
+	glm::dvec2 m_ZoomAnchor;
+	int m_ViewportWidth;
+	int m_ViewportHeight;
+public:
+	static constexpr double MIN_ZOOM = 1.0 / 64.0;
+	static constexpr double MAX_ZOOM = 256.0;
+	//How quickly the zoom catches up with its target, per second
+	static constexpr double ZOOM_SPEED = 18.0;
+
+	Camera();
+	void SetViewport(int width, int height);
+	//Centers a width x height area starting at world (0, 0), e.g. a board, and zooms so it fits the viewport
+	void Fit(double width, double height);
+	//Puts cell at the center of the viewport, keeping the zoom
+	void CenterOn(glm::dvec2 cell);
+	//Moves the view by a distance in pixels, e.g. a mouse drag
+	void Pan(double dx, double dy);
+	//Starts easing the zoom by factor, keeping the cell under the screen point where it is
+	void ZoomAt(glm::dvec2 screen, double factor);
+	//Advances the zoom easing by dt seconds
+	void Update(double dt);
+
+	glm::dvec2 ScreenToCell(glm::dvec2 screen) const;
+	glm::dvec2 CellToScreen(glm::dvec2 cell) const;
+
+	//The same view with cells counted from origin, for a board that only covers part of the world
+	//starting there. Exact for any origin a double holds exactly.
+	Camera Relative(glm::i64vec2 origin) const;
+
+	//Integer cell near the center of the view; cell positions are sent to the GPU relative to it
+	glm::i64vec2 Rebase() const;
+	//Maps cell coordinates relative to origin to clip space. Cell edges land on whole pixels
+	//whenever a cell is a whole number of pixels wide.
+	glm::mat4 ViewProjection(glm::i64vec2 origin) const;
+
+	double Zoom() const { return m_Zoom; }
+	glm::dvec2 Center() const { return m_Center; }
+	int ViewportWidth() const { return m_ViewportWidth; }
+	int ViewportHeight() const { return m_ViewportHeight; }
+
+	//Between two camera states, for rendering between simulation ticks. Zoom is blended
+	//logarithmically so that zooming looks uniform.
+	static Camera Interpolate(const Camera& from, const Camera& to, double alpha);
+};
+#endif
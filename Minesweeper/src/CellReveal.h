@@ -0,0 +1,27 @@
+#ifndef CELL_REVEAL_CLASS
+#define CELL_REVEAL_CLASS
+#include <cstdint>
+
+//One cell whose look changed: opened by the player, flagged or unflagged, or closed again by an
+//undo. This is all the renderer ever uploads for a change; the ripple itself is computed in
+//res/shaders/tile/vertex.shader from the time uniform.
+struct CellReveal
+{
+	//What a cell shows: the number of an open safe cell, 0 to 12, or one of these
+	enum Face : uint32_t
+	{
+		MINE = 13,
+		//On a hidden cell
+		FLAG = 14
+	};
+
+	//Row-major index into the board
+	uint32_t cell;
+	//Game time of the click that opened it, negative while the cell is hidden, e.g. after an undo
+	float time;
+	//Flood fill steps from the clicked cell, which delays its animation
+	float distance;
+	//A number or Face; hidden cells only ever show FLAG or nothing (0)
+	uint32_t face;
+};
+#endif
@@ -0,0 +1,271 @@
+#include "EndlessField.h"
+#include <algorithm>
+#include <iostream>
+#include "Philox.h"
+
+size_t EndlessField::ChunkKeyHash::operator()(const ChunkKey& key) const
+{
+	//SplitMix64 finalizer over both coordinates, neighboring chunks end up far apart
+	uint64_t hash = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(key.y);
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+	return static_cast<size_t>(hash ^ (hash >> 31));
+}
+
+EndlessField::EndlessField()
+	: m_Seed(0), m_MinesPerChunk(0), m_Budget(SIZE_MAX), m_LastKey{ 0, 0 }, m_LastEntry(nullptr), m_SpillBytes(0)
+{
+}
+
+void EndlessField::Reset(const uint64_t seed, const unsigned int minesPerChunk)
+{
+	m_Seed = seed;
+	m_MinesPerChunk = minesPerChunk;
+	m_Chunks.clear();
+	m_Recent.clear();
+	m_LastEntry = nullptr;
+
+	//The old board's records are useless now, start the file over
+	if (m_Spill.is_open())
+		m_Spill.close();
+	m_Spilled.clear();
+	m_SpillBytes = 0;
+}
+
+void EndlessField::SetMemoryBudget(const size_t budget, const std::string& spillPath)
+{
+	m_Budget = budget;
+	if (spillPath != m_SpillPath)
+	{
+		//The index holds offsets into the current file, a new one would be written over them
+		if (!m_Spilled.empty())
+			std::cout << "SPILL FILE " << m_SpillPath << " HOLDS CHUNKS, IGNORING NEW PATH " << spillPath << std::endl;
+		else
+		{
+			if (m_Spill.is_open())
+				m_Spill.close();
+			m_SpillPath = spillPath;
+		}
+	}
+	Evict();
+}
+
+EndlessField::Entry& EndlessField::EntryAt(const int64_t chunkX, const int64_t chunkY)
+{
+	const ChunkKey key{ chunkX, chunkY };
+	if (m_LastEntry && m_LastKey == key)
+		return *m_LastEntry;
+
+	const auto [found, inserted] = m_Chunks.try_emplace(key);
+	Entry& entry = found->second;
+	if (inserted)
+	{
+		Generate(entry.chunk, chunkX, chunkY);
+		const auto spilled = m_Spilled.find(key);
+		if (spilled != m_Spilled.end())
+			PageIn(spilled->second, entry.chunk);
+		entry.modified = false;
+		m_Recent.push_front(key);
+		entry.recent = m_Recent.begin();
+	}
+	else
+	{
+		m_Recent.splice(m_Recent.begin(), m_Recent, entry.recent);
+	}
+	m_LastKey = key;
+	m_LastEntry = &entry;
+
+	if (inserted)
+		Evict();
+	return entry;
+}
+
+//Drops chunks from the cold end of m_Recent until the budget is met. The chunk just looked up is at
+//the hot end and never goes. Spilling grows the index, so the budget is checked again every time.
+void EndlessField::Evict()
+{
+	while (m_Chunks.size() > MIN_CHUNKS && ResidentBytes() > m_Budget)
+	{
+		const ChunkKey key = m_Recent.back();
+		const auto found = m_Chunks.find(key);
+		const Entry& entry = found->second;
+		bool hasState = false;
+		for (const uint64_t row : entry.chunk.revealed)
+			hasState = hasState || row != 0;
+
+		//Without a spill file there is nowhere to put player state, so the budget has to give
+		if (hasState && entry.modified && !Spill(key, entry.chunk))
+			return;
+
+		if (m_LastEntry == &entry)
+			m_LastEntry = nullptr;
+		m_Recent.pop_back();
+		m_Chunks.erase(found);
+	}
+}
+
+//Record: chunk x, chunk y, a mask of the non-zero rows of revealed, then those rows. Mines are not
+//stored, they regenerate from the seed.
+bool EndlessField::Spill(const ChunkKey& key, const Chunk& chunk)
+{
+	if (!m_Spill.is_open())
+	{
+		m_Spill.open(m_SpillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_Spill.is_open())
+		{
+			std::cout << "ERROR OPENING SPILL FILE " << m_SpillPath << ", KEEPING CHUNKS IN MEMORY" << std::endl;
+			m_Budget = SIZE_MAX;
+			return false;
+		}
+	}
+
+	uint64_t rows = 0;
+	for (int y = 0; y < CHUNK_SIZE; y++)
+		rows |= static_cast<uint64_t>(chunk.revealed[y] != 0) << y;
+
+	const uint64_t offset = m_SpillBytes;
+	m_Spill.seekp(static_cast<std::streamoff>(offset));
+	m_Spill.write(reinterpret_cast<const char*>(&key.x), sizeof(key.x));
+	m_Spill.write(reinterpret_cast<const char*>(&key.y), sizeof(key.y));
+	m_Spill.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+	uint64_t written = sizeof(key.x) + sizeof(key.y) + sizeof(rows);
+	for (int y = 0; y < CHUNK_SIZE; y++)
+	{
+		if (!chunk.revealed[y])
+			continue;
+		m_Spill.write(reinterpret_cast<const char*>(&chunk.revealed[y]), sizeof(uint64_t));
+		written += sizeof(uint64_t);
+	}
+	if (!m_Spill)
+	{
+		std::cout << "ERROR WRITING SPILL FILE " << m_SpillPath << ", KEEPING CHUNKS IN MEMORY" << std::endl;
+		m_Spill.clear();
+		m_Budget = SIZE_MAX;
+		return false;
+	}
+
+	m_SpillBytes += written;
+	m_Spilled[key] = offset;
+	return true;
+}
+
+void EndlessField::PageIn(const uint64_t offset, Chunk& chunk)
+{
+	int64_t x, y;
+	uint64_t rows;
+	m_Spill.seekg(static_cast<std::streamoff>(offset));
+	m_Spill.read(reinterpret_cast<char*>(&x), sizeof(x));
+	m_Spill.read(reinterpret_cast<char*>(&y), sizeof(y));
+	m_Spill.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+	for (int row = 0; row < CHUNK_SIZE; row++)
+		if ((rows >> row) & 1)
+			m_Spill.read(reinterpret_cast<char*>(&chunk.revealed[row]), sizeof(uint64_t));
+	if (!m_Spill)
+	{
+		std::cout << "ERROR READING SPILL FILE " << m_SpillPath << " AT " << offset << std::endl;
+		m_Spill.clear();
+	}
+}
+
+//Floyd's sampling over the chunk's bits, as in MineField, on the Philox stream of the chunk's
+//coordinates. Coordinates are packed rather than hashed into the stream so no two chunks within
+//2^31 chunks of the start can ever share one.
+void EndlessField::Generate(Chunk& chunk, const int64_t chunkX, const int64_t chunkY) const
+{
+	chunk.mines.fill(0);
+	chunk.revealed.fill(0);
+
+	//START AREA, sorted because it is collected row by row
+	int excluded[9];
+	int excludedCount = 0;
+	for (int64_t y = -1; y <= 1; y++)
+		for (int64_t x = -1; x <= 1; x++)
+			if (ChunkOf(x) == chunkX && ChunkOf(y) == chunkY)
+				excluded[excludedCount++] = Local(y) * CHUNK_SIZE + Local(x);
+
+	const auto cellOf = [&](int index)
+	{
+		for (int i = 0; i < excludedCount && excluded[i] <= index; i++)
+			index++;
+		return index;
+	};
+	const auto test = [&](const int cell) { return (chunk.mines[cell / CHUNK_SIZE] >> (cell % CHUNK_SIZE)) & 1; };
+
+	Philox random(m_Seed, static_cast<uint32_t>(chunkX) | static_cast<uint64_t>(static_cast<uint32_t>(chunkY)) << 32);
+	const int free = CHUNK_SIZE * CHUNK_SIZE - excludedCount;
+	const int mines = static_cast<int>(m_MinesPerChunk) < free ? static_cast<int>(m_MinesPerChunk) : free;
+	for (int j = free - mines; j < free; j++)
+	{
+		int cell = cellOf(static_cast<int>(random.Below(static_cast<uint64_t>(j) + 1)));
+		if (test(cell))
+			cell = cellOf(j);
+		chunk.mines[cell / CHUNK_SIZE] |= uint64_t(1) << (cell % CHUNK_SIZE);
+	}
+}
+
+bool EndlessField::IsMine(const int64_t x, const int64_t y)
+{
+	return (ChunkAt(ChunkOf(x), ChunkOf(y)).mines[Local(y)] >> Local(x)) & 1;
+}
+
+bool EndlessField::IsRevealed(const int64_t x, const int64_t y)
+{
+	return (ChunkAt(ChunkOf(x), ChunkOf(y)).revealed[Local(y)] >> Local(x)) & 1;
+}
+
+int EndlessField::AdjacentMines(const int64_t x, const int64_t y)
+{
+	//Away from the chunk's edges the three rows are in this chunk, count them straight from the words
+	const int localX = Local(x);
+	const int localY = Local(y);
+	if (localX > 0 && localX < CHUNK_SIZE - 1 && localY > 0 && localY < CHUNK_SIZE - 1)
+	{
+		const Chunk& chunk = ChunkAt(ChunkOf(x), ChunkOf(y));
+		int count = 0;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			//The three cells around x, without x itself on its own row
+			const uint64_t bits = (chunk.mines[localY + dy] >> (localX - 1)) & (dy == 0 ? 5 : 7);
+			count += static_cast<int>((bits & 1) + ((bits >> 1) & 1) + (bits >> 2));
+		}
+		return count;
+	}
+
+	int count = 0;
+	for (int64_t dy = -1; dy <= 1; dy++)
+		for (int64_t dx = -1; dx <= 1; dx++)
+			count += (dx != 0 || dy != 0) && IsMine(x + dx, y + dy);
+	return count;
+}
+
+void EndlessField::Reveal(const int64_t x, const int64_t y, std::vector<RevealedCell>& revealed)
+{
+	const auto open = [this](const int64_t cellX, const int64_t cellY)
+	{
+		Entry& entry = EntryAt(ChunkOf(cellX), ChunkOf(cellY));
+		uint64_t& row = entry.chunk.revealed[Local(cellY)];
+		const uint64_t bit = uint64_t(1) << Local(cellX);
+		if (row & bit)
+			return false;
+		row |= bit;
+		entry.modified = true;
+		return true;
+	};
+
+	if (!open(x, y))
+		return;
+
+	//Breadth first like the fixed board's flood; crossing into a chunk that was never touched generates it
+	const size_t first = revealed.size();
+	revealed.push_back({ x, y, 0.0f });
+	for (size_t next = first; next < revealed.size(); next++)
+	{
+		const RevealedCell current = revealed[next];
+		if (IsMine(current.x, current.y) || AdjacentMines(current.x, current.y) > 0)
+			continue;
+		for (int64_t dy = -1; dy <= 1; dy++)
+			for (int64_t dx = -1; dx <= 1; dx++)
+				if (open(current.x + dx, current.y + dy))
+					revealed.push_back({ current.x + dx, current.y + dy, current.distance + 1.0f });
+	}
+}
@@ -0,0 +1,154 @@
+#ifndef ENDLESS_FIELD_CLASS
+#define ENDLESS_FIELD_CLASS
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//An unbounded board for endless mode. Cells are grouped into CHUNK_SIZE x CHUNK_SIZE chunks kept
+//in a hash map and generated the first time anything touches them, so memory grows with the area
+//the player has explored and not with any board size. A chunk's mines are a pure function of
+//(seed, chunk coordinates); the 3x3 block around cell (0, 0), where the game starts, is always clear.
+//
+//Past a memory budget the least recently used chunks are evicted. One the player never changed is
+//dropped, it regenerates from the seed; one with player state is appended to a spill file first
+//and paged back in from there the next time it is touched.
+class EndlessField
+{
+public:
+	static const int CHUNK_SIZE = 64;
+
+	//One bit per cell, bit x of word y
+	struct Chunk
+	{
+		std::array<uint64_t, CHUNK_SIZE> mines;
+		std::array<uint64_t, CHUNK_SIZE> revealed;
+	};
+
+	//A cell opened by Reveal, in steps from the clicked cell
+	struct RevealedCell
+	{
+		int64_t x;
+		int64_t y;
+		float distance;
+	};
+private:
+	struct ChunkKey
+	{
+		int64_t x;
+		int64_t y;
+		bool operator==(const ChunkKey& other) const { return x == other.x && y == other.y; }
+	};
+	struct ChunkKeyHash
+	{
+		size_t operator()(const ChunkKey& key) const;
+	};
+	struct Entry
+	{
+		Chunk chunk;
+		//Position in m_Recent
+		std::list<ChunkKey>::iterator recent;
+		//Changed since it was generated or paged in, so the spill file does not have this state yet
+		bool modified;
+	};
+
+	uint64_t m_Seed;
+	unsigned int m_MinesPerChunk;
+	std::unordered_map<ChunkKey, Entry, ChunkKeyHash> m_Chunks;
+	//Most recently used first
+	std::list<ChunkKey> m_Recent;
+	//Bytes ResidentBytes may reach, SIZE_MAX for no limit
+	size_t m_Budget;
+	//Floods touch the same chunk over and over, skip the hash lookup for those. Map nodes never
+	//move, so the pointer stays valid until the chunk is evicted, and the last chunk never is.
+	ChunkKey m_LastKey;
+	Entry* m_LastEntry;
+
+	//SPILL FILE: records are appended and never rewritten; the index points at each chunk's newest.
+	//The index stays in memory and counts towards the budget, so the more chunks are spilled the fewer
+	//stay resident.
+	std::string m_SpillPath;
+	std::fstream m_Spill;
+	std::unordered_map<ChunkKey, uint64_t, ChunkKeyHash> m_Spilled;
+	uint64_t m_SpillBytes;
+public:
+	//Per node of a hash map: the next pointer, the cached hash and the bucket pointing at it
+	static const size_t MAP_NODE_BYTES = 3 * sizeof(void*);
+	//Bytes a resident chunk costs: its map node and its LRU list node
+	static const size_t CHUNK_BYTES = sizeof(std::pair<const ChunkKey, Entry>) + MAP_NODE_BYTES + sizeof(ChunkKey) + 2 * sizeof(void*);
+	//Bytes a spill index entry costs
+	static const size_t SPILLED_BYTES = sizeof(std::pair<const ChunkKey, uint64_t>) + MAP_NODE_BYTES;
+	//Never evicted below this many, so every chunk a single lookup can touch fits. Past about
+	//budget / SPILLED_BYTES spilled chunks the index alone is over budget and these are all that stay.
+	static const size_t MIN_CHUNKS = 16;
+
+	EndlessField();
+	//Forgets every chunk, empties the spill file and starts a different board. Below about 10% mines
+	//the cells without adjacent mines percolate and a single reveal can flood forever.
+	void Reset(uint64_t seed, unsigned int minesPerChunk);
+	//Evicts chunks beyond budget bytes, spilling those with player state to spillPath. The path
+	//cannot change while chunks are spilled; set it again after Reset.
+	void SetMemoryBudget(size_t budget, const std::string& spillPath);
+
+	bool IsMine(int64_t x, int64_t y);
+	bool IsRevealed(int64_t x, int64_t y);
+	//Mines among the 8 neighbors, generating neighboring chunks as needed
+	int AdjacentMines(int64_t x, int64_t y);
+	//Opens (x, y) and floods through cells with no adjacent mines, appending every newly opened
+	//cell to revealed in breadth first order
+	void Reveal(int64_t x, int64_t y, std::vector<RevealedCell>& revealed);
+	//Calls visit(x, y) for each revealed cell in [x0, x1) x [y0, y1), e.g. to fill a view that moved.
+	//Only chunks that were ever touched can have any, the others are skipped without generating them.
+	template <typename Visit>
+	void ForEachRevealed(int64_t x0, int64_t y0, int64_t x1, int64_t y1, const Visit& visit);
+
+	uint64_t Seed() const { return m_Seed; }
+	size_t ChunkCount() const { return m_Chunks.size(); }
+	//Resident chunks and the spill index, what the budget limits
+	size_t ResidentBytes() const { return m_Chunks.size() * CHUNK_BYTES + m_Spilled.size() * SPILLED_BYTES; }
+	size_t SpilledChunks() const { return m_Spilled.size(); }
+	uint64_t SpillBytes() const { return m_SpillBytes; }
+private:
+	Chunk& ChunkAt(const int64_t chunkX, const int64_t chunkY) { return EntryAt(chunkX, chunkY).chunk; }
+	Entry& EntryAt(int64_t chunkX, int64_t chunkY);
+	void Evict();
+	bool Spill(const ChunkKey& key, const Chunk& chunk);
+	void PageIn(uint64_t offset, Chunk& chunk);
+	void Generate(Chunk& chunk, int64_t chunkX, int64_t chunkY) const;
+	static int64_t ChunkOf(const int64_t cell) { return cell >= 0 ? cell / CHUNK_SIZE : -((CHUNK_SIZE - 1 - cell) / CHUNK_SIZE); }
+	static int Local(const int64_t cell) { return static_cast<int>(cell - ChunkOf(cell) * CHUNK_SIZE); }
+};
+
+template <typename Visit>
+void EndlessField::ForEachRevealed(const int64_t x0, const int64_t y0, const int64_t x1, const int64_t y1, const Visit& visit)
+{
+	for (int64_t chunkY = ChunkOf(y0); chunkY * CHUNK_SIZE < y1; chunkY++)
+	{
+		for (int64_t chunkX = ChunkOf(x0); chunkX * CHUNK_SIZE < x1; chunkX++)
+		{
+			const ChunkKey key{ chunkX, chunkY };
+			if (m_Chunks.find(key) == m_Chunks.end() && m_Spilled.find(key) == m_Spilled.end())
+				continue;
+			//A copy: visit may look at neighbors, which can evict this chunk
+			const std::array<uint64_t, CHUNK_SIZE> revealed = ChunkAt(chunkX, chunkY).revealed;
+			for (int row = 0; row < CHUNK_SIZE; row++)
+			{
+				const int64_t y = chunkY * CHUNK_SIZE + row;
+				if (revealed[row] == 0 || y < y0 || y >= y1)
+					continue;
+				for (int column = 0; column < CHUNK_SIZE; column++)
+				{
+					const int64_t x = chunkX * CHUNK_SIZE + column;
+					if ((revealed[row] >> column & 1) && x >= x0 && x < x1)
+						visit(x, y);
+				}
+			}
+		}
+	}
+}
+#endif
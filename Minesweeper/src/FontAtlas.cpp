@@ -0,0 +1,136 @@
+#include "FontAtlas.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	//Strokes of each glyph as polylines separated by '|', each point two digits "xy" on the
+	//GRID_WIDTH x GRID_HEIGHT grid with y going down. A point on its own is a dot.
+	struct GlyphStrokes
+	{
+		char character;
+		const char* strokes;
+	};
+
+	const GlyphStrokes STROKES[] =
+	{
+		{ '0', "00 40 46 06 00|06 40" }, { '1', "11 20 26|16 36" }, { '2', "00 40 43 03 06 46" },
+		{ '3', "00 40 46 06|03 43" }, { '4', "00 03 43|40 46" }, { '5', "40 00 03 43 46 06" },
+		{ '6', "40 00 06 46 43 03" }, { '7', "00 40 46" }, { '8', "00 40 46 06 00|03 43" },
+		{ '9', "43 03 00 40 46 06" },
+		{ 'A', "06 02 20 42 46|03 43" }, { 'B', "06 00 30 41 42 33 03|33 44 45 36 06" }, { 'C', "40 00 06 46" },
+		{ 'D', "00 30 42 44 36 06 00" }, { 'E', "40 00 06 46|03 33" }, { 'F', "40 00 06|03 33" },
+		{ 'G', "40 00 06 46 43 23" }, { 'H', "00 06|40 46|03 43" }, { 'I', "10 30|20 26|16 36" },
+		{ 'J', "40 46 06 04" }, { 'K', "00 06|40 03 46" }, { 'L', "00 06 46" },
+		{ 'M', "06 00 23 40 46" }, { 'N', "06 00 46 40" }, { 'O', "00 40 46 06 00" },
+		{ 'P', "06 00 40 43 03" }, { 'Q', "00 40 46 06 00|24 46" }, { 'R', "06 00 40 43 03|23 46" },
+		{ 'S', "41 40 00 03 43 46 06 05" }, { 'T', "00 40|20 26" }, { 'U', "00 06 46 40" },
+		{ 'V', "00 26 40" }, { 'W', "00 06 23 46 40" }, { 'X', "00 46|40 06" },
+		{ 'Y', "00 23 40|23 26" }, { 'Z', "00 40 06 46" },
+		{ ':', "22|25" }, { '.', "26" }, { ',', "25 16" }, { '-', "13 33" }, { '+', "13 33|22 24" },
+		{ '=', "12 32|14 34" }, { '/', "40 06" }, { '%', "00|40 06|46" }, { '(', "30 11 15 36" },
+		{ ')', "10 31 35 16" }, { '!', "20 23|26" }, { '?', "01 10 30 41 42 23 24|26" }, { '\'', "20 21" },
+		{ '_', "06 46" }, { '#', "10 16|30 36|02 42|04 44" }, { '<', "30 03 36" }, { '>', "10 43 16" },
+		{ '*', "11 35|31 15|13 33" }, { '[', "30 10 16 36" }, { ']', "10 30 36 16" }
+	};
+
+	//Half the stroke width, in grid units
+	const float STROKE_RADIUS = 0.45f;
+
+	float DistanceToSegment(const float px, const float py, const float ax, const float ay, const float bx, const float by)
+	{
+		const float dx = bx - ax;
+		const float dy = by - ay;
+		const float lengthSquared = dx * dx + dy * dy;
+		float t = 0.0f;
+		if (lengthSquared > 0.0f)
+			t = std::clamp(((px - ax) * dx + (py - ay) * dy) / lengthSquared, 0.0f, 1.0f);
+		const float x = ax + t * dx - px;
+		const float y = ay + t * dy - py;
+		return std::sqrt(x * x + y * y);
+	}
+}
+
+FontAtlas::FontAtlas()
+	: m_Width(COLUMNS * CELL_WIDTH),
+	  m_Height(((CHARACTERS + COLUMNS - 1) / COLUMNS) * CELL_HEIGHT),
+	  m_Pixels(static_cast<size_t>(m_Width) * m_Height, 0)
+{
+	for (int index = 0; index < CHARACTERS; index++)
+	{
+		const int x = (index % COLUMNS) * CELL_WIDTH;
+		const int y = (index / COLUMNS) * CELL_HEIGHT;
+		m_Glyphs[index] = Glyph{ static_cast<float>(x) / m_Width, static_cast<float>(y) / m_Height,
+		                         static_cast<float>(x + CELL_WIDTH) / m_Width, static_cast<float>(y + CELL_HEIGHT) / m_Height };
+	}
+
+	for (const GlyphStrokes& glyph : STROKES)
+		Rasterize(glyph.character - FIRST_CHARACTER, glyph.strokes);
+
+	const int solid = SOLID - FIRST_CHARACTER;
+	for (int y = 0; y < CELL_HEIGHT; y++)
+	{
+		unsigned char* row = &m_Pixels[static_cast<size_t>((solid / COLUMNS) * CELL_HEIGHT + y) * m_Width + (solid % COLUMNS) * CELL_WIDTH];
+		std::fill(row, row + CELL_WIDTH, static_cast<unsigned char>(255));
+	}
+}
+
+const FontAtlas::Glyph& FontAtlas::GetGlyph(char character) const
+{
+	if (character >= 'a' && character <= 'z')
+		character = static_cast<char>(character - 'a' + 'A');
+	int index = static_cast<unsigned char>(character) - FIRST_CHARACTER;
+	if (index < 0 || index >= CHARACTERS)
+		index = '?' - FIRST_CHARACTER;
+	return m_Glyphs[index];
+}
+
+void FontAtlas::Rasterize(const int index, const std::string_view strokes)
+{
+	//SEGMENTS in grid units
+	std::vector<std::array<float, 4>> segments;
+	float lastX = 0.0f, lastY = 0.0f;
+	bool hasLast = false;
+	for (size_t i = 0; i < strokes.size(); i++)
+	{
+		const char c = strokes[i];
+		if (c == '|')
+		{
+			hasLast = false;
+			continue;
+		}
+		if (c == ' ' || i + 1 >= strokes.size())
+			continue;
+
+		const float x = static_cast<float>(c - '0');
+		const float y = static_cast<float>(strokes[i + 1] - '0');
+		i++;
+		//A point on its own becomes a zero length segment, i.e. a dot
+		const bool alone = !hasLast && (i + 1 >= strokes.size() || strokes[i + 1] == '|');
+		if (hasLast || alone)
+			segments.push_back({ hasLast ? lastX : x, hasLast ? lastY : y, x, y });
+		lastX = x;
+		lastY = y;
+		hasLast = true;
+	}
+
+	//DISTANCE FIELD sampled at texel centers
+	const int cellX = (index % COLUMNS) * CELL_WIDTH;
+	const int cellY = (index / COLUMNS) * CELL_HEIGHT;
+	for (int y = 0; y < CELL_HEIGHT; y++)
+	{
+		for (int x = 0; x < CELL_WIDTH; x++)
+		{
+			const float gridX = (x + 0.5f - PADDING) / TEXELS_PER_UNIT;
+			const float gridY = (y + 0.5f - PADDING) / TEXELS_PER_UNIT;
+			float distance = 1e9f;
+			for (const std::array<float, 4>& segment : segments)
+				distance = std::min(distance, DistanceToSegment(gridX, gridY, segment[0], segment[1], segment[2], segment[3]));
+
+			//Signed distance to the stroke outline in texels, positive inside
+			const float inside = (STROKE_RADIUS - distance) * TEXELS_PER_UNIT;
+			const float value = std::clamp(0.5f + inside / (2.0f * SPREAD), 0.0f, 1.0f);
+			m_Pixels[static_cast<size_t>(cellY + y) * m_Width + cellX + x] = static_cast<unsigned char>(std::lround(value * 255.0f));
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef FONT_ATLAS_CLASS
+#define FONT_ATLAS_CLASS
+#include <array>
+#include <string_view>
+#include <vector>
+
+//Signed distance field atlas of the printable ASCII range, generated from a built in stroke
+//font: every glyph is a few line segments on a GRID_WIDTH x GRID_HEIGHT grid, so the distance
+//field is exact and takes a few milliseconds to compute at startup. There is no font file to
+//ship and nothing to keep in sync with one.
+//
+//Texels store 0.5 on the outline, rising inside. One atlas scales cleanly to any text size.
+class FontAtlas
+{
+public:
+	static const int GRID_WIDTH = 4;
+	static const int GRID_HEIGHT = 6;
+	//Atlas texels per grid unit, and the empty border around each glyph for the field to fade out in
+	static const int TEXELS_PER_UNIT = 5;
+	static const int PADDING = 6;
+	static const int CELL_WIDTH = GRID_WIDTH * TEXELS_PER_UNIT + 2 * PADDING;
+	static const int CELL_HEIGHT = GRID_HEIGHT * TEXELS_PER_UNIT + 2 * PADDING;
+	static const int COLUMNS = 16;
+	static const char FIRST_CHARACTER = ' ';
+	static const int CHARACTERS = 96;
+	//Distance in texels from the outline at which the field reaches 0 or 1
+	static const int SPREAD = PADDING;
+	//The DEL slot is filled solid, so rectangles can be drawn with the text shader and atlas
+	//and batch together with the text
+	static const char SOLID = 127;
+
+	//Texture coordinates of a glyph's cell, padding included
+	struct Glyph
+	{
+		float u0, v0, u1, v1;
+	};
+private:
+	int m_Width;
+	int m_Height;
+	std::vector<unsigned char> m_Pixels;
+	std::array<Glyph, CHARACTERS> m_Glyphs;
+public:
+	FontAtlas();
+	int Width() const { return m_Width; }
+	int Height() const { return m_Height; }
+	//One byte per texel, rows top to bottom
+	const std::vector<unsigned char>& Pixels() const { return m_Pixels; }
+	//Characters outside the atlas come out as '?', lower case as upper case
+	const Glyph& GetGlyph(char character) const;
+	//Width in grid units including the gap to the next character
+	static float Advance() { return GRID_WIDTH + 1.0f; }
+private:
+	void Rasterize(int index, std::string_view strokes);
+};
+#endif
@@ -0,0 +1,49 @@
+#include "FrameBufferObject.h"
+
+FrameBufferObject::FrameBufferObject(const int width, const int height)
+	: m_Width(width), m_Height(height)
+{
+	glGenTextures(1, &m_Texture);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffers(1, &m_Id);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_Texture, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+FrameBufferObject::~FrameBufferObject()
+{
+	this->Delete();
+}
+
+void FrameBufferObject::Delete() const
+{
+	glDeleteFramebuffers(1, &m_Id);
+	glDeleteTextures(1, &m_Texture);
+}
+
+void FrameBufferObject::Bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+	glViewport(0, 0, m_Width, m_Height);
+}
+
+void FrameBufferObject::Unbind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool FrameBufferObject::IsComplete() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+	const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	return complete;
+}
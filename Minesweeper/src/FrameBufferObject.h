@@ -0,0 +1,25 @@
+#ifndef FRAME_BUFFER_OBJECT_CLASS
+#define FRAME_BUFFER_OBJECT_CLASS
+#include <glad/glad.h>
+
+//Offscreen render target with a single RGBA8 color texture
+class FrameBufferObject
+{
+public:
+	unsigned int m_Id;
+	unsigned int m_Texture;
+	int m_Width;
+	int m_Height;
+private:
+	void Delete() const;
+public:
+	FrameBufferObject(int width, int height);
+	~FrameBufferObject();
+	FrameBufferObject(const FrameBufferObject&) = delete;
+	FrameBufferObject& operator=(const FrameBufferObject&) = delete;
+	//Also sets the viewport to cover the whole target
+	void Bind() const;
+	void Unbind() const;
+	bool IsComplete() const;
+};
+#endif
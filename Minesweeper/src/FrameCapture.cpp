@@ -0,0 +1,227 @@
+#include "FrameCapture.h"
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "PngWriter.h"
+
+//Jobs waiting for the encoder before new frames are dropped (~a quarter second of video at 60 fps)
+static const size_t MAX_QUEUED_JOBS = 16;
+
+FrameCapture::FrameCapture(const int width, const int height, const size_t ringSize)
+	: m_Width(width), m_Height(height), m_Slots(ringSize), m_First(0), m_InFlight(0),
+	  m_Recording(false), m_RecordedFrames(0), m_Stopping(false)
+{
+	Allocate();
+	m_Worker = std::thread(&FrameCapture::WorkerLoop, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+	//Shutting down is the one place where waiting on the GPU is fine
+	CollectFinished(true);
+	Release();
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_WorkAvailable.notify_one();
+	m_Worker.join();
+}
+
+void FrameCapture::Allocate()
+{
+	for (Slot& slot : m_Slots)
+	{
+		glGenBuffers(1, &slot.m_Buffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.m_Buffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, FrameBytes(), nullptr, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::Release()
+{
+	for (Slot& slot : m_Slots)
+	{
+		if (slot.m_Fence)
+			glDeleteSync(slot.m_Fence);
+		glDeleteBuffers(1, &slot.m_Buffer);
+		slot = Slot();
+	}
+	m_First = 0;
+	m_InFlight = 0;
+}
+
+void FrameCapture::Screenshot(const std::string& path)
+{
+	m_ScreenshotPath = path;
+}
+
+void FrameCapture::StartRecording(const std::string& directory)
+{
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	m_RecordingDirectory = directory;
+	m_RecordedFrames = 0;
+	m_Recording = true;
+}
+
+void FrameCapture::StopRecording()
+{
+	m_Recording = false;
+}
+
+bool FrameCapture::IsRecording() const
+{
+	return m_Recording;
+}
+
+void FrameCapture::EndFrame()
+{
+	CollectFinished(false);
+
+	std::string path;
+	if (!m_ScreenshotPath.empty())
+	{
+		path = m_ScreenshotPath;
+		m_ScreenshotPath.clear();
+	}
+	else if (m_Recording)
+	{
+		std::ostringstream name;
+		name << m_RecordingDirectory << "/frame_" << std::setw(6) << std::setfill('0') << m_RecordedFrames++ << ".png";
+		path = name.str();
+	}
+	if (path.empty())
+		return;
+
+	if (m_InFlight == m_Slots.size())
+	{
+		m_Stats.dropped++;
+		return;
+	}
+
+	//READ INTO THE NEXT FREE BUFFER, the copy happens on the GPU timeline
+	Slot& slot = m_Slots[(m_First + m_InFlight) % m_Slots.size()];
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.m_Buffer);
+	glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	slot.m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot.m_Path = path;
+	m_InFlight++;
+}
+
+//Maps every capture whose fence has signalled, oldest first, and hands the pixels to the worker
+void FrameCapture::CollectFinished(const bool wait)
+{
+	while (m_InFlight > 0)
+	{
+		Slot& slot = m_Slots[m_First];
+
+		//Flushing on the first check makes sure the fence actually reaches the GPU
+		const GLuint64 timeout = wait ? 1000000000ull : 0;
+		const GLenum status = glClientWaitSync(slot.m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		if (status == GL_TIMEOUT_EXPIRED && !wait)
+			return;
+
+		if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+		{
+			m_Stats.dropped++;
+		}
+		else
+		{
+			Job job{ slot.m_Path, m_Width, m_Height, {} };
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (!m_FreePixels.empty())
+				{
+					job.m_Pixels = std::move(m_FreePixels.back());
+					m_FreePixels.pop_back();
+				}
+			}
+			job.m_Pixels.resize(FrameBytes());
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.m_Buffer);
+			const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, FrameBytes(), GL_MAP_READ_BIT);
+			if (pixels)
+			{
+				std::memcpy(job.m_Pixels.data(), pixels, FrameBytes());
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				Queue(std::move(job));
+			}
+			else
+			{
+				m_Stats.dropped++;
+			}
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		glDeleteSync(slot.m_Fence);
+		slot.m_Fence = nullptr;
+		m_First = (m_First + 1) % m_Slots.size();
+		m_InFlight--;
+	}
+}
+
+void FrameCapture::Queue(Job job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Jobs.size() >= MAX_QUEUED_JOBS)
+		{
+			m_FreePixels.push_back(std::move(job.m_Pixels));
+			m_Stats.dropped++;
+			return;
+		}
+		m_Jobs.push_back(std::move(job));
+	}
+	m_Stats.captured++;
+	m_WorkAvailable.notify_one();
+}
+
+void FrameCapture::WorkerLoop()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WorkAvailable.wait(lock, [this] { return m_Stopping || !m_Jobs.empty(); });
+			if (m_Jobs.empty())
+				return;
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+		}
+
+		if (!PngWriter::Write(job.m_Path, job.m_Width, job.m_Height, job.m_Pixels.data(), true))
+			std::cout << "ERROR WRITING CAPTURE TO " << job.m_Path << std::endl;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_FreePixels.push_back(std::move(job.m_Pixels));
+	}
+}
+
+void FrameCapture::Resize(const int width, const int height)
+{
+	if (width == m_Width && height == m_Height)
+		return;
+
+	Release();
+	m_Width = width;
+	m_Height = height;
+	Allocate();
+}
+
+FrameCapture::Stats FrameCapture::GetStats() const
+{
+	return m_Stats;
+}
+
+size_t FrameCapture::FrameBytes() const
+{
+	return static_cast<size_t>(m_Width) * m_Height * 4;
+}
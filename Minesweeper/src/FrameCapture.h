@@ -0,0 +1,85 @@
+#ifndef FRAME_CAPTURE_CLASS
+#define FRAME_CAPTURE_CLASS
+#include <glad/glad.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Screenshots and frame recording without stalling the render loop.
+//glReadPixels goes into a ring of pixel pack buffers, each guarded by a fence. The pixels are only
+//mapped a few frames later once the fence has signalled, and the PNG is encoded on a worker thread.
+//If the ring or the encoder falls behind, frames are dropped rather than waited for.
+class FrameCapture
+{
+public:
+	struct Stats
+	{
+		unsigned int captured = 0;
+		unsigned int dropped = 0;
+	};
+private:
+	struct Slot
+	{
+		unsigned int m_Buffer = 0;
+		GLsync m_Fence = nullptr;
+		std::string m_Path;
+	};
+
+	struct Job
+	{
+		std::string m_Path;
+		int m_Width;
+		int m_Height;
+		std::vector<unsigned char> m_Pixels;
+	};
+
+	int m_Width;
+	int m_Height;
+	std::vector<Slot> m_Slots;
+	//Index of the oldest capture still in flight, and how many are in flight
+	size_t m_First;
+	size_t m_InFlight;
+
+	std::string m_ScreenshotPath;
+	std::string m_RecordingDirectory;
+	bool m_Recording;
+	unsigned int m_RecordedFrames;
+	//Only touched on the GL thread
+	Stats m_Stats;
+
+	//Everything below is shared with the worker thread and guarded by m_Mutex
+	std::thread m_Worker;
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkAvailable;
+	std::deque<Job> m_Jobs;
+	std::vector<std::vector<unsigned char>> m_FreePixels;
+	bool m_Stopping;
+public:
+	//ringSize is how many frames a readback may take before its slot is needed again
+	FrameCapture(int width, int height, size_t ringSize = 3);
+	~FrameCapture();
+
+	//Saves the next finished frame to path
+	void Screenshot(const std::string& path);
+	//Saves every frame as directory/frame_000000.png until stopped
+	void StartRecording(const std::string& directory);
+	void StopRecording();
+	bool IsRecording() const;
+
+	//Call after the frame is rendered and before swapping buffers. Never blocks.
+	void EndFrame();
+	//Call from the framebuffer size callback. Captures in flight at the old size are discarded.
+	void Resize(int width, int height);
+	Stats GetStats() const;
+private:
+	void Allocate();
+	void Release();
+	void CollectFinished(bool wait);
+	void Queue(Job job);
+	void WorkerLoop();
+	size_t FrameBytes() const;
+};
+#endif
@@ -0,0 +1,14 @@
+#include "GLCounters.h"
+
+GLCounters& GLCounters::Current()
+{
+	static thread_local GLCounters counters;
+	return counters;
+}
+
+GLCounters GLCounters::Take()
+{
+	const GLCounters counters = Current();
+	Current() = GLCounters();
+	return counters;
+}
@@ -0,0 +1,20 @@
+#ifndef GL_COUNTERS_CLASS
+#define GL_COUNTERS_CLASS
+#include <cstdint>
+
+//Per frame counts of GL work, bumped at the call sites. Each thread has its own, and only the
+//render thread ever issues GL calls, so counting needs no synchronization.
+struct GLCounters
+{
+	unsigned int drawCalls = 0;
+	//Calls skipped because the state they set was already current
+	unsigned int elidedCalls = 0;
+	//Bytes handed to glBufferData/glBufferSubData/glTexSubImage2D
+	uint64_t uploadBytes = 0;
+
+	//The calling thread's counters
+	static GLCounters& Current();
+	//Returns the counts so far and starts over
+	static GLCounters Take();
+};
+#endif
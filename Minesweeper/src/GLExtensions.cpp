@@ -0,0 +1,49 @@
+#include "GLExtensions.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace GLExtensions
+{
+	PFNGLMAXSHADERCOMPILERTHREADSKHRPROC MaxShaderCompilerThreadsKHR = nullptr;
+
+	void Load(const GLADloadproc loader)
+	{
+		if (IsSupported("GL_KHR_parallel_shader_compile"))
+			MaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)loader("glMaxShaderCompilerThreadsKHR");
+		else if (IsSupported("GL_ARB_parallel_shader_compile"))
+			MaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)loader("glMaxShaderCompilerThreadsARB");
+	}
+
+	bool IsSupported(const char* name)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++)
+		{
+			const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (extension && std::strcmp(extension, name) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool HasParallelShaderCompile()
+	{
+		return MaxShaderCompilerThreadsKHR != nullptr;
+	}
+
+	bool HasSpirvShaders()
+	{
+		//glSpecializeShader is only loaded by glad for a 4.6 context
+		if (!GLAD_GL_VERSION_4_6)
+			return false;
+
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &count);
+		std::vector<GLint> formats(count);
+		if (count > 0)
+			glGetIntegerv(GL_SHADER_BINARY_FORMATS, formats.data());
+		return std::find(formats.begin(), formats.end(), GL_SHADER_BINARY_FORMAT_SPIR_V) != formats.end();
+	}
+}
@@ -0,0 +1,26 @@
+#ifndef GL_EXTENSIONS_CLASS
+#define GL_EXTENSIONS_CLASS
+#include <glad/glad.h>
+
+//glad was generated without extensions, so the few we use are declared and loaded here.
+
+//GL_KHR_parallel_shader_compile (same values as the ARB version)
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+namespace GLExtensions
+{
+	//Null when neither GL_KHR_parallel_shader_compile nor GL_ARB_parallel_shader_compile is available
+	extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC MaxShaderCompilerThreadsKHR;
+
+	//Call once after gladLoadGLLoader with the same loader
+	void Load(GLADloadproc loader);
+	bool IsSupported(const char* name);
+	bool HasParallelShaderCompile();
+	//GL 4.6 / ARB_gl_spirv with GL_SHADER_BINARY_FORMAT_SPIR_V among the accepted binary formats
+	bool HasSpirvShaders();
+}
+#endif
@@ -0,0 +1,39 @@
+#include "GameClock.h"
+
+GameClock::GameClock(const Clock::time_point start)
+	: m_Start(start), m_Tick(0)
+{
+}
+
+unsigned int GameClock::Advance(const Clock::time_point now)
+{
+	if (now < NextTick())
+		return 0;
+
+	const uint64_t due = static_cast<uint64_t>((now - m_Start) / STEP);
+	uint64_t ticks = due - m_Tick;
+	if (ticks > MAX_CATCH_UP_TICKS)
+	{
+		//Shift tick 0 so the skipped time never happened as far as the game is concerned
+		m_Start += STEP * (ticks - MAX_CATCH_UP_TICKS);
+		ticks = MAX_CATCH_UP_TICKS;
+	}
+
+	m_Tick += ticks;
+	return static_cast<unsigned int>(ticks);
+}
+
+double GameClock::Time() const
+{
+	return std::chrono::duration<double>(STEP * m_Tick).count();
+}
+
+double GameClock::TimeAt(const Clock::time_point instant) const
+{
+	return std::chrono::duration<double>(instant - m_Start).count();
+}
+
+GameClock::Clock::time_point GameClock::TimeOfTick(const uint64_t tick) const
+{
+	return m_Start + STEP * tick;
+}
@@ -0,0 +1,35 @@
+#ifndef GAME_CLOCK_CLASS
+#define GAME_CLOCK_CLASS
+#include <chrono>
+#include <cstdint>
+
+//Fixed-step simulation clock on steady_clock. The game advances in whole ticks of STEP no
+//matter how often frames are presented; the renderer interpolates between the last two.
+class GameClock
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	static constexpr std::chrono::nanoseconds STEP = std::chrono::nanoseconds(std::chrono::seconds(1)) / 240;
+	//After a stall (debugger, window drag) at most this many ticks are caught up, the rest of
+	//the gap is skipped so the simulation never spirals trying to catch up with the wall clock
+	static constexpr unsigned int MAX_CATCH_UP_TICKS = 24;
+private:
+	//Wall time of tick 0. Moves forward when ticks are skipped after a stall.
+	Clock::time_point m_Start;
+	uint64_t m_Tick;
+public:
+	explicit GameClock(Clock::time_point start = Clock::now());
+	//Advances to the last tick due at now and returns how many ticks passed
+	unsigned int Advance(Clock::time_point now);
+
+	uint64_t Tick() const { return m_Tick; }
+	//Game time in seconds at the current tick
+	double Time() const;
+	//Game time in seconds at an arbitrary instant, e.g. an input event's timestamp, so
+	//timing is not quantized to ticks
+	double TimeAt(Clock::time_point instant) const;
+	//Wall time at which the given tick is (or was) due
+	Clock::time_point TimeOfTick(uint64_t tick) const;
+	Clock::time_point NextTick() const { return TimeOfTick(m_Tick + 1); }
+};
+#endif
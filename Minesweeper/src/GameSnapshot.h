@@ -0,0 +1,47 @@
+#ifndef GAME_SNAPSHOT_CLASS
+#define GAME_SNAPSHOT_CLASS
+#include <chrono>
+#include <cstdint>
+#include "Camera.h"
+
+//Everything the render thread needs to draw one simulation state. Copied by value through
+//the snapshot queue, so the renderer never reads game state the simulation is changing.
+struct GameSnapshot
+{
+	uint64_t tick = 0;
+	//Wall time this tick was due; the renderer interpolates between snapshots by it
+	std::chrono::steady_clock::time_point tickTime;
+	//Simulation time in seconds at this tick
+	double time = 0.0;
+	//Seconds on the in-game stopwatch at this tick
+	double stopwatch = 0.0;
+	//Mines minus flags, shown in the HUD
+	int mineCounter = 0;
+	//How the game ended, shown on the face button
+	bool won = false;
+	bool lost = false;
+	//How long the board engine took the last time it ran, for the performance overlay; negative before that
+	float revealMilliseconds = -1.0f;
+	float solverMilliseconds = -1.0f;
+	//Hint lookups answered from the cache and solved afresh since the game started
+	size_t hintHits = 0;
+	size_t hintMisses = 0;
+	Camera camera;
+	//Toggled with H; drawn with the HOVER_HIGHLIGHT tile variant
+	bool highlighted = false;
+	//Delivery time of the oldest input whose effect first shows up in this snapshot.
+	//Default constructed (the clock's epoch) when no new input went into it.
+	std::chrono::steady_clock::time_point inputTime;
+
+	//The state between two ticks, alpha = 0 giving from and 1 giving to. Continuous values
+	//are blended; discrete ones are taken from to so input shows up without waiting a tick.
+	static GameSnapshot Interpolate(const GameSnapshot& from, const GameSnapshot& to, const double alpha)
+	{
+		GameSnapshot result = to;
+		result.time = from.time + (to.time - from.time) * alpha;
+		result.stopwatch = from.stopwatch + (to.stopwatch - from.stopwatch) * alpha;
+		result.camera = Camera::Interpolate(from.camera, to.camera, alpha);
+		return result;
+	}
+};
+#endif
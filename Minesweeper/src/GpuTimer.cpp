@@ -0,0 +1,49 @@
+#include "GpuTimer.h"
+#include <glad/glad.h>
+
+GpuTimer::GpuTimer(const int passes)
+	: m_Passes(passes),
+	  m_Queries(static_cast<size_t>(FRAMES_IN_FLIGHT) * passes, 0),
+	  m_Issued(static_cast<size_t>(FRAMES_IN_FLIGHT) * passes, false),
+	  m_Milliseconds(passes, 0.0),
+	  m_Frame(0)
+{
+	glGenQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data());
+}
+
+GpuTimer::~GpuTimer()
+{
+	glDeleteQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data());
+}
+
+void GpuTimer::BeginFrame()
+{
+	m_Frame = (m_Frame + 1) % FRAMES_IN_FLIGHT;
+	for (int pass = 0; pass < m_Passes; pass++)
+	{
+		const size_t index = static_cast<size_t>(m_Frame) * m_Passes + pass;
+		if (!m_Issued[index])
+			continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(m_Queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available)
+		{
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(m_Queries[index], GL_QUERY_RESULT, &nanoseconds);
+			m_Milliseconds[pass] = nanoseconds / 1e6;
+		}
+		m_Issued[index] = false;
+	}
+}
+
+void GpuTimer::Begin(const int pass)
+{
+	glBeginQuery(GL_TIME_ELAPSED, m_Queries[static_cast<size_t>(m_Frame) * m_Passes + pass]);
+}
+
+void GpuTimer::End(const int pass)
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	m_Issued[static_cast<size_t>(m_Frame) * m_Passes + pass] = true;
+}
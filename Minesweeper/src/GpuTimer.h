@@ -0,0 +1,31 @@
+#ifndef GPU_TIMER_CLASS
+#define GPU_TIMER_CLASS
+#include <cstddef>
+#include <vector>
+
+//GPU time per render pass from GL_TIME_ELAPSED queries. Results are read FRAMES_IN_FLIGHT
+//frames after they were issued, once the GPU is done with them, so timing never stalls the
+//pipeline; a result that is still not there by then is dropped.
+class GpuTimer
+{
+private:
+	static const int FRAMES_IN_FLIGHT = 4;
+
+	int m_Passes;
+	//FRAMES_IN_FLIGHT rows of m_Passes queries
+	std::vector<unsigned int> m_Queries;
+	std::vector<bool> m_Issued;
+	std::vector<double> m_Milliseconds;
+	int m_Frame;
+public:
+	explicit GpuTimer(int passes);
+	~GpuTimer();
+	//Collects the results of the oldest frame in flight and makes its queries reusable
+	void BeginFrame();
+	//Passes can not overlap
+	void Begin(int pass);
+	void End(int pass);
+	//Latest result for pass, a few frames old
+	double Milliseconds(int pass) const { return m_Milliseconds[pass]; }
+};
+#endif
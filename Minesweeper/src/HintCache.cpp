@@ -0,0 +1,33 @@
+#include "HintCache.h"
+
+HintCache::HintCache(const size_t capacity)
+	: m_Capacity(capacity), m_Hits(0), m_Misses(0)
+{
+}
+
+bool HintCache::Find(const uint64_t hash, BoardTypes::Hint& hint)
+{
+	const auto entry = m_Entries.find(hash);
+	if (entry == m_Entries.end())
+	{
+		m_Misses++;
+		return false;
+	}
+	m_Hits++;
+	hint = entry->second;
+	return true;
+}
+
+void HintCache::Insert(const uint64_t hash, const BoardTypes::Hint& hint)
+{
+	if (m_Entries.size() >= m_Capacity)
+		m_Entries.clear();
+	m_Entries[hash] = hint;
+}
+
+void HintCache::Clear()
+{
+	m_Entries.clear();
+	m_Hits = 0;
+	m_Misses = 0;
+}
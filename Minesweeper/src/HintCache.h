@@ -0,0 +1,30 @@
+#ifndef HINT_CACHE_CLASS
+#define HINT_CACHE_CLASS
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "Board.h"
+
+//Solver results by position hash (BasicBoard::Hash), so asking again for the same position, e.g.
+//after an undo, costs a lookup instead of a walk over the board. Hashes are only comparable within
+//a game, so it is cleared for each new one. Past capacity entries it starts
+//over rather than tracking which ones are old; positions of a game are rarely revisited far back.
+class HintCache
+{
+private:
+	std::unordered_map<uint64_t, BoardTypes::Hint> m_Entries;
+	size_t m_Capacity;
+	size_t m_Hits;
+	size_t m_Misses;
+public:
+	explicit HintCache(size_t capacity = 4096);
+	//False when hash was not cached
+	bool Find(uint64_t hash, BoardTypes::Hint& hint);
+	void Insert(uint64_t hash, const BoardTypes::Hint& hint);
+	//Forgets every entry and starts the hit and miss counts over
+	void Clear();
+
+	size_t Hits() const { return m_Hits; }
+	size_t Misses() const { return m_Misses; }
+};
+#endif
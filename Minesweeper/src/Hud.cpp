@@ -0,0 +1,109 @@
+#include "Hud.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const glm::vec4 BAR_COLOR(0.75f, 0.75f, 0.75f, 1.0f);
+	const glm::vec4 DISPLAY_COLOR(0.0f, 0.0f, 0.0f, 1.0f);
+	const glm::vec4 SEGMENT_ON(1.0f, 0.1f, 0.1f, 1.0f);
+	const glm::vec4 SEGMENT_OFF(0.25f, 0.03f, 0.03f, 1.0f);
+	const glm::vec4 FACE_BORDER(0.45f, 0.45f, 0.45f, 1.0f);
+	const glm::vec4 FACE_COLOR(1.0f, 0.85f, 0.1f, 1.0f);
+	const glm::vec4 FACE_HIGHLIGHTED(1.0f, 0.95f, 0.55f, 1.0f);
+	const glm::vec4 FACE_WON(0.3f, 0.85f, 0.35f, 1.0f);
+	const glm::vec4 FACE_LOST(0.9f, 0.25f, 0.2f, 1.0f);
+	const glm::vec4 LABEL_COLOR(0.2f, 0.2f, 0.2f, 1.0f);
+	const float LABEL_HEIGHT = 12.0f;
+
+	const float MARGIN = 8.0f;
+	const float DIGIT_WIDTH = 18.0f;
+	const float DIGIT_HEIGHT = 32.0f;
+	const float DIGIT_SPACING = 4.0f;
+	const float SEGMENT = 3.0f;
+	const int DIGITS = 3;
+
+	//Segments a-g as bits 0-6: top, top right, bottom right, bottom, bottom left, top left, middle
+	const unsigned char SEGMENTS[10] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+	const unsigned char MINUS = 0x40;
+
+	void DrawDigit(SpriteBatch& batch, const float x, const float y, const unsigned char segments)
+	{
+		const float half = DIGIT_HEIGHT / 2.0f;
+		const glm::vec4 rects[7] =
+		{
+			{ x + SEGMENT, y, DIGIT_WIDTH - 2 * SEGMENT, SEGMENT },
+			{ x + DIGIT_WIDTH - SEGMENT, y + SEGMENT, SEGMENT, half - 1.5f * SEGMENT },
+			{ x + DIGIT_WIDTH - SEGMENT, y + half + 0.5f * SEGMENT, SEGMENT, half - 1.5f * SEGMENT },
+			{ x + SEGMENT, y + DIGIT_HEIGHT - SEGMENT, DIGIT_WIDTH - 2 * SEGMENT, SEGMENT },
+			{ x, y + half + 0.5f * SEGMENT, SEGMENT, half - 1.5f * SEGMENT },
+			{ x, y + SEGMENT, SEGMENT, half - 1.5f * SEGMENT },
+			{ x + SEGMENT, y + half - 0.5f * SEGMENT, DIGIT_WIDTH - 2 * SEGMENT, SEGMENT }
+		};
+		for (int i = 0; i < 7; i++)
+			batch.Draw(rects[i].x, rects[i].y, rects[i].z, rects[i].w, (segments >> i) & 1 ? SEGMENT_ON : SEGMENT_OFF, 2);
+	}
+
+	//Three digits on a black panel, clamped to -99..999 like the original
+	void DrawCounter(SpriteBatch& batch, const float x, const float y, const int value)
+	{
+		const float panelWidth = DIGITS * DIGIT_WIDTH + (DIGITS + 1) * DIGIT_SPACING;
+		batch.Draw(x, y, panelWidth, DIGIT_HEIGHT + 2 * DIGIT_SPACING, DISPLAY_COLOR, 1);
+
+		const int clamped = std::min(std::max(value, -99), 999);
+		int remaining = std::abs(clamped);
+		for (int i = DIGITS - 1; i >= 0; i--)
+		{
+			unsigned char segments = SEGMENTS[remaining % 10];
+			if (clamped < 0 && i == 0)
+				segments = MINUS;
+			DrawDigit(batch, x + DIGIT_SPACING + i * (DIGIT_WIDTH + DIGIT_SPACING), y + DIGIT_SPACING, segments);
+			remaining /= 10;
+		}
+	}
+}
+
+namespace
+{
+	//x, y, size
+	glm::vec4 FaceRect(const int width)
+	{
+		const float faceSize = Hud::BAR_HEIGHT - 2 * MARGIN + 4.0f;
+		return glm::vec4((width - faceSize) / 2.0f, (Hud::BAR_HEIGHT - faceSize) / 2.0f, faceSize, 0.0f);
+	}
+}
+
+bool Hud::HitFace(const double x, const double y, const int width)
+{
+	const glm::vec4 face = FaceRect(width);
+	return x >= face.x && x < face.x + face.z && y >= face.y && y < face.y + face.z;
+}
+
+void Hud::Draw(SpriteBatch& batch, const TextRenderer& text, const GameSnapshot& snapshot, const int width)
+{
+	const float barWidth = static_cast<float>(width);
+	batch.Draw(0.0f, 0.0f, barWidth, BAR_HEIGHT, BAR_COLOR);
+
+	const float panelWidth = DIGITS * DIGIT_WIDTH + (DIGITS + 1) * DIGIT_SPACING;
+	const float panelY = (BAR_HEIGHT - DIGIT_HEIGHT - 2 * DIGIT_SPACING) / 2.0f;
+	DrawCounter(batch, MARGIN, panelY, snapshot.mineCounter);
+	DrawCounter(batch, barWidth - MARGIN - panelWidth, panelY, static_cast<int>(std::floor(snapshot.stopwatch)));
+
+	//LABELS next to the displays, where there is room between them and the face
+	const float labelY = (BAR_HEIGHT - LABEL_HEIGHT) / 2.0f;
+	if (barWidth > 2 * (MARGIN + panelWidth + text.Measure("MINES", LABEL_HEIGHT)) + BAR_HEIGHT + 4 * MARGIN)
+	{
+		text.Draw(batch, "MINES", MARGIN + panelWidth + MARGIN, labelY, LABEL_HEIGHT, LABEL_COLOR);
+		const float timeWidth = text.Measure("TIME", LABEL_HEIGHT);
+		text.Draw(batch, "TIME", barWidth - MARGIN - panelWidth - MARGIN - timeWidth, labelY, LABEL_HEIGHT, LABEL_COLOR);
+	}
+
+	//FACE BUTTON
+	const glm::vec4 face = FaceRect(width);
+	const float faceX = face.x;
+	const float faceY = face.y;
+	const float faceSize = face.z;
+	batch.Draw(faceX, faceY, faceSize, faceSize, FACE_BORDER, 1);
+	const glm::vec4& faceColor = snapshot.won ? FACE_WON : snapshot.lost ? FACE_LOST : snapshot.highlighted ? FACE_HIGHLIGHTED : FACE_COLOR;
+	batch.Draw(faceX + 3.0f, faceY + 3.0f, faceSize - 6.0f, faceSize - 6.0f, faceColor, 2);
+}
@@ -0,0 +1,17 @@
+#ifndef HUD_CLASS
+#define HUD_CLASS
+#include "GameSnapshot.h"
+#include "SpriteBatch.h"
+#include "TextRenderer.h"
+
+//The classic bar above the board: mine counter, face button and timer made of plain rectangles,
+//so the bar is one batched draw, plus labels that add the one draw for all text
+namespace Hud
+{
+	const float BAR_HEIGHT = 48.0f;
+
+	void Draw(SpriteBatch& batch, const TextRenderer& text, const GameSnapshot& snapshot, int width);
+	//Whether a point in framebuffer pixels is on the face button of a bar width pixels wide
+	bool HitFace(double x, double y, int width);
+}
+#endif
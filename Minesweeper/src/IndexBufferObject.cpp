@@ -26,3 +26,9 @@ void IndexBufferObject::Unbind() const
 {
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
+
+void IndexBufferObject::SetData(const void* data, const unsigned int size) const
+{
+	this->Bind();
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+}
@@ -12,5 +12,7 @@ public:
 	~IndexBufferObject();
 	void Bind() const;
 	void Unbind() const;
+	//Replaces the indices; the VAO they belong to must be bound
+	void SetData(const void* data, unsigned int size) const;
 };
 #endif
@@ -0,0 +1,28 @@
+#ifndef INPUT_EVENT_CLASS
+#define INPUT_EVENT_CLASS
+#include <chrono>
+
+//One GLFW callback, stamped when it was delivered so the time until its effect is on screen can be measured
+struct InputEvent
+{
+	enum Type
+	{
+		KEY,
+		MOUSE_BUTTON,
+		CURSOR_MOVE,
+		SCROLL
+	};
+
+	Type type = KEY;
+	//KEY: GLFW_KEY_*, MOUSE_BUTTON: GLFW_MOUSE_BUTTON_*
+	int code = 0;
+	//GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+	int action = 0;
+	//GLFW_MOD_*; SCROLL only has GLFW_MOD_CONTROL
+	int mods = 0;
+	//Cursor position in window coordinates, SCROLL: wheel offsets
+	double x = 0.0;
+	double y = 0.0;
+	std::chrono::steady_clock::time_point time;
+};
+#endif
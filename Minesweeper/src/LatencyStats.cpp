@@ -0,0 +1,42 @@
+#include "LatencyStats.h"
+#include <algorithm>
+#include <vector>
+
+LatencyStats::LatencyStats()
+	: m_Samples(), m_Count(0), m_Next(0)
+{
+}
+
+void LatencyStats::Add(const std::chrono::steady_clock::time_point input, const std::chrono::steady_clock::time_point presented)
+{
+	m_Samples[m_Next] = std::chrono::duration<double, std::milli>(presented - input).count();
+	m_Next = (m_Next + 1) % WINDOW;
+	m_Count = std::min(m_Count + 1, WINDOW);
+}
+
+LatencyStats::Summary LatencyStats::Summarize() const
+{
+	Summary summary;
+	if (m_Count == 0)
+		return summary;
+
+	std::vector<double> sorted(m_Samples.begin(), m_Samples.begin() + m_Count);
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (const double sample : sorted)
+		total += sample;
+
+	summary.samples = m_Count;
+	summary.minimum = sorted.front();
+	summary.average = total / m_Count;
+	summary.p99 = sorted[std::min(m_Count - 1, m_Count * 99 / 100)];
+	summary.maximum = sorted.back();
+	return summary;
+}
+
+void LatencyStats::Clear()
+{
+	m_Count = 0;
+	m_Next = 0;
+}
@@ -0,0 +1,30 @@
+#ifndef LATENCY_STATS_CLASS
+#define LATENCY_STATS_CLASS
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+//Rolling window of input-to-present latencies, in milliseconds
+class LatencyStats
+{
+public:
+	struct Summary
+	{
+		size_t samples = 0;
+		double minimum = 0.0;
+		double average = 0.0;
+		double p99 = 0.0;
+		double maximum = 0.0;
+	};
+private:
+	static const size_t WINDOW = 256;
+	std::array<double, WINDOW> m_Samples;
+	size_t m_Count;
+	size_t m_Next;
+public:
+	LatencyStats();
+	void Add(std::chrono::steady_clock::time_point input, std::chrono::steady_clock::time_point presented);
+	Summary Summarize() const;
+	void Clear();
+};
+#endif
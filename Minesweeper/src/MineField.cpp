@@ -0,0 +1,213 @@
+#include "MineField.h"
+#include <algorithm>
+#include <cassert>
+#include "Philox.h"
+
+MineField::MineField()
+	: m_Columns(0), m_Rows(0), m_Mines(0), m_Seed(0)
+{
+}
+
+void MineField::Clear(const int columns, const int rows)
+{
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Mines = 0;
+	m_Words.assign((static_cast<size_t>(columns) * rows + 63) / 64, 0);
+	m_Counts.assign(m_Words.size() * 32, 0);
+}
+
+void MineField::Generate(const int columns, const int rows, const size_t mines, const uint64_t seed, const int safeColumn, const int safeRow, ThreadPool* pool)
+{
+	Clear(columns, rows);
+	size_t excluded[9];
+	const size_t excludedCount = SafeCells(columns, rows, safeColumn, safeRow, excluded);
+	Fill(mines, seed, excluded, excludedCount, true, pool);
+}
+
+void MineField::Place(const int columns, const int rows, const size_t mines, const uint64_t seed, const size_t* excluded, const size_t excludedCount, ThreadPool* pool)
+{
+	Clear(columns, rows);
+	Fill(mines, seed, excluded, excludedCount, false, pool);
+}
+
+//Two passes over fixed chunks of CHUNK_CELLS cells:
+//1. Each chunk places its share of the mines with its own Philox stream (board seed, chunk index + 1)
+//   and counts the cells whose neighbors are all inside it.
+//2. Once every chunk has its mines, the cells along chunk borders are counted.
+//Without count only the first pass places mines. Nothing depends on which thread ran a chunk or
+//when, so the output is the same for any pool.
+void MineField::Fill(const size_t mines, const uint64_t seed, const size_t* excluded, const size_t excludedCount, const bool count, ThreadPool* pool)
+{
+	m_Seed = seed;
+	const int columns = m_Columns;
+	const size_t cells = static_cast<size_t>(columns) * m_Rows;
+	const size_t candidates = cells - excludedCount;
+	m_Mines = std::min(mines, candidates);
+
+	//SHARE OF EACH CHUNK: proportional to its free cells, rounded down, with the remainder going to
+	//chunks picked by Floyd's sampling on stream 0. Mines per chunk are therefore fixed to within
+	//one rather than hypergeometric, the price of chunks not having to wait for each other.
+	const size_t chunkCount = (cells + CHUNK_CELLS - 1) / CHUNK_CELLS;
+	//In 64 bits: mines times free cells overflows a 32 bit size_t on any board of more than one chunk
+	std::vector<uint64_t> chunkMines(chunkCount);
+	std::vector<bool> extra(chunkCount, false);
+	uint64_t allocated = 0;
+	for (size_t chunk = 0; chunk < chunkCount; chunk++)
+	{
+		const size_t start = chunk * CHUNK_CELLS;
+		const size_t end = std::min(start + CHUNK_CELLS, cells);
+		const size_t inside = std::count_if(excluded, excluded + excludedCount, [&](const size_t cell) { return cell >= start && cell < end; });
+		chunkMines[chunk] = candidates == 0 ? 0 : static_cast<uint64_t>(m_Mines) * (end - start - inside) / candidates;
+		allocated += chunkMines[chunk];
+	}
+	Philox allocation(seed, 0);
+	for (size_t j = chunkCount - static_cast<size_t>(m_Mines - allocated); j < chunkCount; j++)
+	{
+		size_t chunk = static_cast<size_t>(allocation.Below(j + 1));
+		if (extra[chunk])
+			chunk = j;
+		extra[chunk] = true;
+		chunkMines[chunk]++;
+		allocated++;
+	}
+	assert(allocated == m_Mines);
+
+	const auto generateChunk = [&](const size_t chunk)
+	{
+		const size_t start = chunk * CHUNK_CELLS;
+		const size_t end = std::min(start + CHUNK_CELLS, cells);
+		Philox random(seed, chunk + 1);
+		Sample(m_Words.data(), start, end, static_cast<size_t>(chunkMines[chunk]), excluded, excludedCount, random);
+		if (!count)
+			return;
+
+		//INTERIOR COUNTS, while the chunk is still in cache
+		const size_t reach = static_cast<size_t>(columns) + 1;
+		for (size_t word = start / 64; word * 64 < end; word++)
+			if (word * 64 >= start + reach && word * 64 + 64 + reach <= end)
+				CountWord(word);
+	};
+
+	const auto fixBorders = [&](const size_t chunk)
+	{
+		const size_t start = chunk * CHUNK_CELLS;
+		const size_t end = std::min(start + CHUNK_CELLS, cells);
+		const size_t reach = static_cast<size_t>(columns) + 1;
+		for (size_t word = start / 64; word * 64 < end; word++)
+			if (word * 64 < start + reach || word * 64 + 64 + reach > end)
+				CountWord(word);
+	};
+
+	if (pool)
+	{
+		pool->ParallelFor(chunkCount, generateChunk);
+		if (count)
+			pool->ParallelFor(chunkCount, fixBorders);
+	}
+	else
+	{
+		for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			generateChunk(chunk);
+		for (size_t chunk = 0; count && chunk < chunkCount; chunk++)
+			fixBorders(chunk);
+	}
+}
+
+size_t MineField::SafeCells(const int columns, const int rows, const int safeColumn, const int safeRow, size_t (&cells)[9])
+{
+	size_t count = 0;
+	for (int row = std::max(safeRow - 1, 0); row <= std::min(safeRow + 1, rows - 1); row++)
+		for (int column = std::max(safeColumn - 1, 0); column <= std::min(safeColumn + 1, columns - 1); column++)
+			cells[count++] = static_cast<size_t>(row) * columns + column;
+	return count;
+}
+
+//FLOYD'S SAMPLING: for each j in [free - mines, free) take a random t <= j, or j itself if t was
+//already taken. Every subset of the range's size comes out with the same probability, and the
+//board's own bits are the "already taken" set.
+void MineField::Sample(uint64_t* words, const size_t start, const size_t end, const size_t mines, const size_t* excluded, const size_t excludedCount, Philox& random)
+{
+	size_t skipped[MAX_SAFE_CELLS];
+	size_t skippedCount = 0;
+	for (size_t i = 0; i < excludedCount; i++)
+		if (excluded[i] >= start && excluded[i] < end)
+			skipped[skippedCount++] = excluded[i] - start;
+
+	//Index among the range's candidates to bit index on the board. Monotonic, so Floyd's argument still holds.
+	const auto cellOf = [&](size_t index)
+	{
+		for (size_t i = 0; i < skippedCount && skipped[i] <= index; i++)
+			index++;
+		return start + index;
+	};
+	const auto test = [words](const size_t bit) { return (words[bit >> 6] >> (bit & 63)) & 1; };
+
+	const size_t free = end - start - skippedCount;
+	for (size_t j = free - mines; j < free; j++)
+	{
+		size_t cell = cellOf(static_cast<size_t>(random.Below(j + 1)));
+		if (test(cell))
+			cell = cellOf(j);
+		words[cell >> 6] |= uint64_t(1) << (cell & 63);
+	}
+}
+
+uint64_t MineField::BitsAt(const uint64_t* words, const size_t wordCount, const int64_t bit)
+{
+	const int64_t word = bit >= 0 ? bit / 64 : -((63 - bit) / 64);
+	const int shift = static_cast<int>(bit - word * 64);
+	const auto wordAt = [words, wordCount](const int64_t i) -> uint64_t
+	{
+		return i >= 0 && i < static_cast<int64_t>(wordCount) ? words[static_cast<size_t>(i)] : 0;
+	};
+	//The next word is only touched when it holds some of the bits, it may belong to another chunk
+	if (shift == 0)
+		return wordAt(word);
+	return (wordAt(word) >> shift) | (wordAt(word + 1) << (64 - shift));
+}
+
+void MineField::CountWord(const size_t word)
+{
+	const int64_t first = static_cast<int64_t>(word) * 64;
+	const int64_t columns = m_Columns;
+
+	//EDGE LANES, whose left or right neighbors are on another row
+	uint64_t leftEdge = 0;
+	uint64_t rightEdge = 0;
+	const int64_t column = first % columns;
+	for (int64_t lane = (columns - column) % columns; lane < 64; lane += columns)
+		leftEdge |= uint64_t(1) << lane;
+	for (int64_t lane = columns - 1 - column; lane < 64; lane += columns)
+		rightEdge |= uint64_t(1) << lane;
+
+	const uint64_t neighbors[8] =
+	{
+		BitsAt(first - columns - 1) & ~leftEdge, BitsAt(first - columns), BitsAt(first - columns + 1) & ~rightEdge,
+		BitsAt(first - 1) & ~leftEdge, BitsAt(first + 1) & ~rightEdge,
+		BitsAt(first + columns - 1) & ~leftEdge, BitsAt(first + columns), BitsAt(first + columns + 1) & ~rightEdge
+	};
+
+	//BIT-SLICED SUM, one ripple carry add per neighbor into four bit planes
+	uint64_t sum[4] = {};
+	for (const uint64_t plane : neighbors)
+	{
+		uint64_t carry = plane;
+		for (int i = 0; i < 4 && carry; i++)
+		{
+			const uint64_t next = sum[i] & carry;
+			sum[i] ^= carry;
+			carry = next;
+		}
+	}
+
+	uint8_t* counts = &m_Counts[word * 32];
+	for (int lane = 0; lane < 64; lane += 2)
+	{
+		const auto countOf = [&](const int i)
+		{
+			return static_cast<uint8_t>(((sum[0] >> i) & 1) | ((sum[1] >> i) & 1) << 1 | ((sum[2] >> i) & 1) << 2 | ((sum[3] >> i) & 1) << 3);
+		};
+		counts[lane / 2] = static_cast<uint8_t>(countOf(lane) | countOf(lane + 1) << 4);
+	}
+}
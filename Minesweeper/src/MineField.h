@@ -0,0 +1,110 @@
+#ifndef MINE_FIELD_CLASS
+#define MINE_FIELD_CLASS
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ThreadPool.h"
+#include "Topology.h"
+
+class Philox;
+
+//Where the mines are, one bit per cell, row major in 64-bit words, plus every cell's count of
+//adjacent mines as 4-bit nibbles. A field is a pure function of (columns, rows, mines, seed,
+//first click), so a board can be stored as those and regenerated.
+class MineField
+{
+public:
+	//Cells generated together with one random stream. A multiple of 128 so chunks never share a
+	//word of mines or a byte of counts, and small enough that sampling stays in the L2 cache.
+	static const size_t CHUNK_CELLS = size_t(1) << 20;
+	//Cells a first click keeps clear at most: itself and its neighbors on any topology
+	static const size_t MAX_SAFE_CELLS = 13;
+private:
+	int m_Columns;
+	int m_Rows;
+	size_t m_Mines;
+	uint64_t m_Seed;
+	std::vector<uint64_t> m_Words;
+	//Two cells per byte, low nibble first
+	std::vector<uint8_t> m_Counts;
+public:
+	MineField();
+	//Places exactly min(mines, free cells) mines, never in the 3x3 block around (safeColumn, safeRow),
+	//then counts neighbors. Chunks are generated in parallel on pool when one is given; the result is
+	//bit-identical with or without it and for any number of threads.
+	void Generate(int columns, int rows, size_t mines, uint64_t seed, int safeColumn, int safeRow, ThreadPool* pool = nullptr);
+	//Places mines like Generate but around the given cells (ascending, at most MAX_SAFE_CELLS) and
+	//leaves the counts to Recount, for topologies other than the square grid
+	void Place(int columns, int rows, size_t mines, uint64_t seed, const size_t* excluded, size_t excludedCount, ThreadPool* pool = nullptr);
+	//Counts every cell's neighbors on Topology, in bands of rows on pool if given
+	template <typename Topology>
+	void Recount(ThreadPool* pool = nullptr);
+	void Clear(int columns, int rows);
+
+	bool IsMine(const int column, const int row) const
+	{
+		const size_t bit = static_cast<size_t>(row) * m_Columns + column;
+		return (m_Words[bit >> 6] >> (bit & 63)) & 1;
+	}
+	//Mines among the up to 8 neighbors
+	int AdjacentMines(const int column, const int row) const
+	{
+		const size_t cell = static_cast<size_t>(row) * m_Columns + column;
+		return (m_Counts[cell >> 1] >> ((cell & 1) * 4)) & 15;
+	}
+
+	int Columns() const { return m_Columns; }
+	int Rows() const { return m_Rows; }
+	size_t Mines() const { return m_Mines; }
+	uint64_t Seed() const { return m_Seed; }
+	const std::vector<uint64_t>& Words() const { return m_Words; }
+
+	//Cells of the 3x3 block around the first click that stay clear, in ascending order
+	static size_t SafeCells(int columns, int rows, int safeColumn, int safeRow, size_t (&cells)[9]);
+	//Sets exactly mines bits among the cells in [start, end) that are not in excluded (ascending),
+	//drawing from random. Shared with StaticMineField so both place the same mines for a seed.
+	static void Sample(uint64_t* words, size_t start, size_t end, size_t mines, const size_t* excluded, size_t excludedCount, Philox& random);
+	//The 64 bits of words starting at any bit index, zeros outside them
+	static uint64_t BitsAt(const uint64_t* words, size_t wordCount, int64_t bit);
+private:
+	void Fill(size_t mines, uint64_t seed, const size_t* excluded, size_t excludedCount, bool count, ThreadPool* pool);
+	uint64_t BitsAt(const int64_t bit) const { return BitsAt(m_Words.data(), m_Words.size(), bit); }
+	//Counts for the 64 cells of one word, from bit-sliced sums of the 8 shifted neighbor masks
+	void CountWord(size_t word);
+};
+
+template <typename Topology>
+void MineField::Recount(ThreadPool* pool)
+{
+	const auto bitsAt = [this](const int64_t bit) { return BitsAt(bit); };
+	//Bands of an even number of rows, so no two bands share a byte of counts even for odd widths
+	const int bandRows = 64;
+	const auto countBand = [&](const size_t band)
+	{
+		const int firstRow = static_cast<int>(band) * bandRows;
+		for (int row = firstRow; row < std::min(firstRow + bandRows, m_Rows); row++)
+		{
+			for (int column = 0; column < m_Columns; column += 64)
+			{
+				uint64_t sum[4];
+				Topology::CountLanes(column, row, m_Columns, m_Rows, bitsAt, sum);
+				for (int lane = 0; lane < 64 && column + lane < m_Columns; lane++)
+				{
+					const size_t cell = static_cast<size_t>(row) * m_Columns + column + lane;
+					const uint8_t count = static_cast<uint8_t>(((sum[0] >> lane) & 1) | ((sum[1] >> lane) & 1) << 1 | ((sum[2] >> lane) & 1) << 2 | ((sum[3] >> lane) & 1) << 3);
+					uint8_t& pair = m_Counts[cell >> 1];
+					pair = static_cast<uint8_t>((cell & 1) ? (pair & 0x0F) | count << 4 : (pair & 0xF0) | count);
+				}
+			}
+		}
+	};
+
+	const size_t bands = (static_cast<size_t>(m_Rows) + bandRows - 1) / bandRows;
+	if (pool)
+		pool->ParallelFor(bands, countBand);
+	else
+		for (size_t band = 0; band < bands; band++)
+			countBand(band);
+}
+#endif
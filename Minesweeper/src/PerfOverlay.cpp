@@ -0,0 +1,104 @@
+#include "PerfOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+	const float WIDTH = 260.0f;
+	const float PADDING = 6.0f;
+	const float LINE_HEIGHT = 10.0f;
+	const float LINE_SPACING = 5.0f;
+	const float GRAPH_HEIGHT = 50.0f;
+	//Frame time at the top of the graph
+	const float GRAPH_MILLISECONDS = 50.0f;
+	const float TARGET_MILLISECONDS = 1000.0f / 60.0f;
+	const int LAYER = 5;
+
+	const glm::vec4 PANEL_COLOR(0.0f, 0.0f, 0.0f, 0.7f);
+	const glm::vec4 TEXT_COLOR(0.9f, 0.9f, 0.9f, 1.0f);
+	const glm::vec4 TARGET_COLOR(1.0f, 1.0f, 1.0f, 0.35f);
+	const glm::vec4 FAST_COLOR(0.2f, 0.85f, 0.3f, 1.0f);
+	const glm::vec4 SLOW_COLOR(0.95f, 0.8f, 0.2f, 1.0f);
+	const glm::vec4 VERY_SLOW_COLOR(0.95f, 0.25f, 0.2f, 1.0f);
+	const char* const PASS_NAMES[PerfOverlay::PASS_COUNT] = { "BOARD", "HUD  " };
+}
+
+PerfOverlay::PerfOverlay()
+	: m_Next(0), m_Count(0)
+{
+}
+
+void PerfOverlay::Record(const FrameStats& frame)
+{
+	m_Frames[m_Next] = frame;
+	m_Next = (m_Next + 1) % HISTORY;
+	m_Count = std::min(m_Count + 1, HISTORY);
+}
+
+const PerfOverlay::FrameStats& PerfOverlay::Frame(const size_t i) const
+{
+	return m_Frames[(m_Next + HISTORY - 1 - i) % HISTORY];
+}
+
+void PerfOverlay::Draw(SpriteBatch& batch, const TextRenderer& text, const float x, const float y) const
+{
+	if (m_Count == 0)
+		return;
+
+	const int lines = 7;
+	const float height = 2 * PADDING + lines * (LINE_HEIGHT + LINE_SPACING) + GRAPH_HEIGHT;
+	text.DrawRect(batch, x, y, WIDTH, height, PANEL_COLOR, LAYER);
+
+	//NUMBERS: the newest frame, frame rate over the last second or so
+	const FrameStats& latest = Frame(0);
+	const size_t averaged = std::min<size_t>(m_Count, 60);
+	float total = 0.0f;
+	for (size_t i = 0; i < averaged; i++)
+		total += Frame(i).frameMilliseconds;
+	const float average = total / averaged;
+
+	char line[64];
+	float lineY = y + PADDING;
+	const auto print = [&]()
+	{
+		text.Draw(batch, line, x + PADDING, lineY, LINE_HEIGHT, TEXT_COLOR, LAYER + 1);
+		lineY += LINE_HEIGHT + LINE_SPACING;
+	};
+
+	std::snprintf(line, sizeof(line), "FPS %.0f  FRAME %.2f MS", average > 0.0f ? 1000.0f / average : 0.0f, average);
+	print();
+	for (int pass = 0; pass < PASS_COUNT; pass++)
+	{
+		std::snprintf(line, sizeof(line), "%s CPU %.2f GPU %.2f", PASS_NAMES[pass], latest.cpuMilliseconds[pass], latest.gpuMilliseconds[pass]);
+		print();
+	}
+	std::snprintf(line, sizeof(line), "DRAWS %u  ELIDED %u", latest.drawCalls, latest.elidedCalls);
+	print();
+	std::snprintf(line, sizeof(line), "UPLOAD %.1f KB", latest.uploadBytes / 1024.0);
+	print();
+	char reveal[16] = "-";
+	char solver[16] = "-";
+	if (latest.revealMilliseconds >= 0.0f)
+		std::snprintf(reveal, sizeof(reveal), "%.2f", latest.revealMilliseconds);
+	if (latest.solverMilliseconds >= 0.0f)
+		std::snprintf(solver, sizeof(solver), "%.2f", latest.solverMilliseconds);
+	std::snprintf(line, sizeof(line), "REVEAL %s  SOLVER %s MS", reveal, solver);
+	print();
+	std::snprintf(line, sizeof(line), "HINTS %zu CACHED  %zu SOLVED", latest.hintHits, latest.hintMisses);
+	print();
+
+	//GRAPH, newest frame on the right, one bar per frame
+	const float graphX = x + PADDING;
+	const float graphBottom = y + height - PADDING;
+	const float barWidth = (WIDTH - 2 * PADDING) / HISTORY;
+	for (size_t i = 0; i < m_Count; i++)
+	{
+		const float milliseconds = Frame(i).frameMilliseconds;
+		const float barHeight = std::min(milliseconds / GRAPH_MILLISECONDS, 1.0f) * GRAPH_HEIGHT;
+		const glm::vec4& color = milliseconds <= TARGET_MILLISECONDS * 1.2f ? FAST_COLOR
+		                       : milliseconds <= TARGET_MILLISECONDS * 2.2f ? SLOW_COLOR : VERY_SLOW_COLOR;
+		text.DrawRect(batch, graphX + (HISTORY - 1 - i) * barWidth, graphBottom - barHeight, barWidth, barHeight, color, LAYER + 1);
+	}
+	const float targetY = graphBottom - TARGET_MILLISECONDS / GRAPH_MILLISECONDS * GRAPH_HEIGHT;
+	text.DrawRect(batch, graphX, targetY, WIDTH - 2 * PADDING, 1.0f, TARGET_COLOR, LAYER + 1);
+}
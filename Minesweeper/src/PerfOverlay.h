@@ -0,0 +1,53 @@
+#ifndef PERF_OVERLAY_CLASS
+#define PERF_OVERLAY_CLASS
+#include <array>
+#include <cstdint>
+#include "SpriteBatch.h"
+#include "TextRenderer.h"
+
+//Live performance overlay: a frame time graph and the latest numbers of the render loop and
+//the board engine. Frames are recorded into a ring buffer every frame whether it is shown or
+//not; everything it draws is text or solid text-atlas rectangles, so it adds one draw call.
+class PerfOverlay
+{
+public:
+	enum Pass
+	{
+		BOARD_PASS,
+		HUD_PASS,
+		PASS_COUNT
+	};
+
+	struct FrameStats
+	{
+		//Time since the previous frame started
+		float frameMilliseconds = 0.0f;
+		float cpuMilliseconds[PASS_COUNT] = {};
+		//A few frames old, see GpuTimer
+		float gpuMilliseconds[PASS_COUNT] = {};
+		unsigned int drawCalls = 0;
+		unsigned int elidedCalls = 0;
+		uint64_t uploadBytes = 0;
+		//Board engine, measured on the main thread; negative when it has not run yet
+		float revealMilliseconds = -1.0f;
+		float solverMilliseconds = -1.0f;
+		size_t hintHits = 0;
+		size_t hintMisses = 0;
+	};
+
+	static const size_t HISTORY = 240;
+private:
+	std::array<FrameStats, HISTORY> m_Frames;
+	//Index the next frame goes to, and how many are filled
+	size_t m_Next;
+	size_t m_Count;
+public:
+	PerfOverlay();
+	void Record(const FrameStats& frame);
+	//Draws the panel with its top left corner at (x, y)
+	void Draw(SpriteBatch& batch, const TextRenderer& text, float x, float y) const;
+private:
+	//i = 0 is the newest frame
+	const FrameStats& Frame(size_t i) const;
+};
+#endif
@@ -0,0 +1,74 @@
+#ifndef PERSISTENT_ARRAY_CLASS
+#define PERSISTENT_ARRAY_CLASS
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//An array of fixed-size chunks with structural sharing: copying one copies a page table, not the
+//chunks, and replacing a chunk copies only the page it is on. Chunks are immutable once stored,
+//so any number of copies, e.g. undo snapshots, share every chunk none of them replaced.
+//Not thread safe; copies must stay on one thread.
+template <typename T, size_t CHUNK>
+class PersistentArray
+{
+public:
+	using Chunk = std::array<T, CHUNK>;
+	//Chunks per page; pages are what a copy shares or replaces
+	static const size_t PAGE = 64;
+private:
+	using Page = std::array<std::shared_ptr<const Chunk>, PAGE>;
+
+	std::vector<std::shared_ptr<Page>> m_Pages;
+	size_t m_Chunks;
+public:
+	PersistentArray()
+		: m_Chunks(0)
+	{
+	}
+
+	//Every chunk empty
+	void Resize(const size_t chunks)
+	{
+		m_Chunks = chunks;
+		m_Pages.clear();
+		m_Pages.resize((chunks + PAGE - 1) / PAGE);
+		for (std::shared_ptr<Page>& page : m_Pages)
+			page = std::make_shared<Page>();
+	}
+
+	size_t Chunks() const { return m_Chunks; }
+	//Null until the chunk is first set
+	const Chunk* Get(const size_t chunk) const { return (*m_Pages[chunk / PAGE])[chunk % PAGE].get(); }
+
+	void Set(const size_t chunk, std::shared_ptr<const Chunk> data)
+	{
+		std::shared_ptr<Page>& page = m_Pages[chunk / PAGE];
+		//COPY ON WRITE: another array still sees this page as it was
+		if (page.use_count() > 1)
+			page = std::make_shared<Page>(*page);
+		(*page)[chunk % PAGE] = std::move(data);
+	}
+
+	//Calls different(chunk) for each chunk a and b do not share, skipping shared pages whole.
+	//Arrays of different sizes differ everywhere.
+	template <typename Function>
+	static void ForEachDifference(const PersistentArray& a, const PersistentArray& b, const Function& different)
+	{
+		if (a.m_Chunks != b.m_Chunks)
+		{
+			for (size_t chunk = 0; chunk < a.m_Chunks; chunk++)
+				different(chunk);
+			return;
+		}
+		for (size_t page = 0; page < a.m_Pages.size(); page++)
+		{
+			if (a.m_Pages[page] == b.m_Pages[page])
+				continue;
+			for (size_t slot = 0; slot < PAGE && page * PAGE + slot < a.m_Chunks; slot++)
+				if ((*a.m_Pages[page])[slot] != (*b.m_Pages[page])[slot])
+					different(page * PAGE + slot);
+		}
+	}
+};
+#endif
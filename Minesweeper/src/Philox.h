@@ -0,0 +1,92 @@
+#ifndef PHILOX_CLASS
+#define PHILOX_CLASS
+#include <array>
+#include <cstdint>
+
+//Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"). A counter based
+//generator: the output is a pure function of (key, counter), so a stream can be started anywhere
+//and any number of them can be split from one seed without sharing state.
+//The same key and stream always give the same numbers, on every platform and compiler.
+class Philox
+{
+public:
+	using Block = std::array<uint32_t, 4>;
+private:
+	uint64_t m_Key;
+	//Counter words 2 and 3 select the stream, words 0 and 1 count blocks within it
+	uint64_t m_Stream;
+	uint64_t m_Block;
+	Block m_Output;
+	int m_Used;
+public:
+	explicit Philox(const uint64_t key, const uint64_t stream = 0)
+		: m_Key(key), m_Stream(stream), m_Block(0), m_Output(), m_Used(4)
+	{
+	}
+
+	static Block Generate(const uint64_t key, const Block& counter)
+	{
+		const uint64_t M0 = 0xD2511F53;
+		const uint64_t M1 = 0xCD9E8D57;
+		uint32_t k0 = static_cast<uint32_t>(key);
+		uint32_t k1 = static_cast<uint32_t>(key >> 32);
+		Block c = counter;
+		for (int round = 0; round < 10; round++)
+		{
+			const uint64_t p0 = M0 * c[0];
+			const uint64_t p1 = M1 * c[2];
+			c = { static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+			      static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0) };
+			k0 += 0x9E3779B9;
+			k1 += 0xBB67AE85;
+		}
+		return c;
+	}
+
+	uint32_t Next32()
+	{
+		if (m_Used == 4)
+		{
+			m_Output = Generate(m_Key, { static_cast<uint32_t>(m_Block), static_cast<uint32_t>(m_Block >> 32),
+			                             static_cast<uint32_t>(m_Stream), static_cast<uint32_t>(m_Stream >> 32) });
+			m_Block++;
+			m_Used = 0;
+		}
+		return m_Output[m_Used++];
+	}
+
+	uint64_t Next64()
+	{
+		const uint64_t low = Next32();
+		return low | static_cast<uint64_t>(Next32()) << 32;
+	}
+
+	//Uniform in [0, bound), bound > 0. Lemire's multiply and shift, which only rejects when the
+	//low half lands in the biased sliver, so it almost never draws twice.
+	uint64_t Below(const uint64_t bound)
+	{
+		if (bound <= 0xFFFFFFFFull)
+		{
+			const uint32_t range = static_cast<uint32_t>(bound);
+			uint64_t product = static_cast<uint64_t>(Next32()) * range;
+			if (static_cast<uint32_t>(product) < range)
+			{
+				const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+				while (static_cast<uint32_t>(product) < threshold)
+					product = static_cast<uint64_t>(Next32()) * range;
+			}
+			return product >> 32;
+		}
+
+		//Larger than any board this is used for; plain masked rejection is fine here
+		uint64_t mask = bound - 1;
+		mask |= mask >> 1; mask |= mask >> 2; mask |= mask >> 4;
+		mask |= mask >> 8; mask |= mask >> 16; mask |= mask >> 32;
+		uint64_t value;
+		do
+			value = Next64() & mask;
+		while (value >= bound);
+		return value;
+	}
+};
+#endif
@@ -0,0 +1,116 @@
+#include "PngWriter.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	uint32_t Crc32(const unsigned char* data, const size_t size, uint32_t crc = 0)
+	{
+		static uint32_t table[256];
+		static bool tableReady = false;
+		if (!tableReady)
+		{
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t value = i;
+				for (int bit = 0; bit < 8; bit++)
+					value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+				table[i] = value;
+			}
+			tableReady = true;
+		}
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++)
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	void AppendBigEndian(std::vector<unsigned char>& out, const uint32_t value)
+	{
+		out.push_back(static_cast<unsigned char>(value >> 24));
+		out.push_back(static_cast<unsigned char>(value >> 16));
+		out.push_back(static_cast<unsigned char>(value >> 8));
+		out.push_back(static_cast<unsigned char>(value));
+	}
+
+	void WriteChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data)
+	{
+		std::vector<unsigned char> header;
+		AppendBigEndian(header, static_cast<uint32_t>(data.size()));
+		header.insert(header.end(), type, type + 4);
+
+		uint32_t crc = Crc32(header.data() + 4, 4);
+		crc = Crc32(data.data(), data.size(), crc);
+
+		std::vector<unsigned char> footer;
+		AppendBigEndian(footer, crc);
+
+		file.write((const char*)header.data(), header.size());
+		file.write((const char*)data.data(), data.size());
+		file.write((const char*)footer.data(), footer.size());
+	}
+}
+
+namespace PngWriter
+{
+	bool Write(const std::string& path, const int width, const int height, const unsigned char* rgba, const bool flipVertically)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		file.write((const char*)signature, sizeof(signature));
+
+		//IHDR: 8 bits per channel, color type 6 (RGBA), no interlacing
+		std::vector<unsigned char> header;
+		AppendBigEndian(header, static_cast<uint32_t>(width));
+		AppendBigEndian(header, static_cast<uint32_t>(height));
+		header.insert(header.end(), { 8, 6, 0, 0, 0 });
+		WriteChunk(file, "IHDR", header);
+
+		//Every scanline starts with filter type 0
+		const size_t rowSize = static_cast<size_t>(width) * 4;
+		std::vector<unsigned char> scanlines;
+		scanlines.reserve((rowSize + 1) * height);
+		for (int y = 0; y < height; y++)
+		{
+			const int row = flipVertically ? height - 1 - y : y;
+			scanlines.push_back(0);
+			scanlines.insert(scanlines.end(), rgba + row * rowSize, rgba + (row + 1) * rowSize);
+		}
+
+		//zlib stream made of stored deflate blocks (at most 65535 bytes each)
+		std::vector<unsigned char> zlib;
+		zlib.reserve(scanlines.size() + scanlines.size() / 65535 * 5 + 16);
+		zlib.push_back(0x78);
+		zlib.push_back(0x01);
+		uint32_t adlerA = 1, adlerB = 0;
+		size_t offset = 0;
+		do
+		{
+			const size_t blockSize = std::min<size_t>(65535, scanlines.size() - offset);
+			const bool lastBlock = offset + blockSize == scanlines.size();
+			zlib.push_back(lastBlock ? 1 : 0);
+			zlib.push_back(static_cast<unsigned char>(blockSize));
+			zlib.push_back(static_cast<unsigned char>(blockSize >> 8));
+			zlib.push_back(static_cast<unsigned char>(~blockSize));
+			zlib.push_back(static_cast<unsigned char>(~blockSize >> 8));
+			for (size_t i = offset; i < offset + blockSize; i++)
+			{
+				adlerA = (adlerA + scanlines[i]) % 65521;
+				adlerB = (adlerB + adlerA) % 65521;
+			}
+			zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+			offset += blockSize;
+		} while (offset < scanlines.size());
+		AppendBigEndian(zlib, (adlerB << 16) | adlerA);
+		WriteChunk(file, "IDAT", zlib);
+
+		WriteChunk(file, "IEND", {});
+		return static_cast<bool>(file);
+	}
+}
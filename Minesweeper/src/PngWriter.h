@@ -0,0 +1,12 @@
+#ifndef PNG_WRITER_CLASS
+#define PNG_WRITER_CLASS
+#include <string>
+
+namespace PngWriter
+{
+	//Writes 8 bit RGBA pixels as a PNG. The image data is stored uncompressed (deflate "stored" blocks),
+	//which keeps encoding down to a couple of memory passes so a worker thread can keep up with video capture.
+	//flipVertically is for glReadPixels output, whose first row is the bottom of the image.
+	bool Write(const std::string& path, int width, int height, const unsigned char* rgba, bool flipVertically);
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef RENDER_COMMAND_CLASS
+#define RENDER_COMMAND_CLASS
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CellReveal.h"
+#include "Topology.h"
+
+//One-off requests from the input/simulation thread to the render thread
+struct RenderCommand
+{
+	enum Type
+	{
+		RESIZE,
+		SCREENSHOT,
+		START_RECORDING,
+		STOP_RECORDING,
+		//Measures and reports input-to-present latency while enabled
+		TRACK_LATENCY,
+		//Starts a board of width columns and height rows, all hidden
+		NEW_BOARD,
+		REVEAL,
+		//Draws the board from per-chunk offscreen textures while enabled
+		CACHE_BOARD,
+		PERF_OVERLAY
+	};
+
+	Type type = RESIZE;
+	//RESIZE: new framebuffer size, NEW_BOARD: columns and rows
+	int width = 0;
+	int height = 0;
+	//NEW_BOARD: how its cells are shaped and laid out, and the world cell of its cell (0, 0)
+	GridTopology::Kind topology = GridTopology::SQUARE;
+	int64_t originX = 0;
+	int64_t originY = 0;
+	//SCREENSHOT: file, START_RECORDING: directory
+	std::string path;
+	//TRACK_LATENCY, CACHE_BOARD, PERF_OVERLAY: on or off
+	bool enabled = false;
+	//REVEAL: the cells one move opened, flagged or closed
+	std::vector<CellReveal> reveals;
+};
+#endif
@@ -0,0 +1,131 @@
+#include "RenderThread.h"
+#include <algorithm>
+#include <iostream>
+#include "GameClock.h"
+#include "GLExtensions.h"
+#include "LatencyStats.h"
+#include "Renderer.h"
+
+RenderThread::RenderThread(GLFWwindow* window, const int framebufferWidth, const int framebufferHeight)
+	: m_Window(window), m_FramebufferWidth(framebufferWidth), m_FramebufferHeight(framebufferHeight), m_Running(true), m_Failed(false)
+{
+	m_Thread = std::thread(&RenderThread::Run, this);
+}
+
+RenderThread::~RenderThread()
+{
+	m_Running = false;
+	m_Thread.join();
+}
+
+bool RenderThread::Submit(RenderCommand command)
+{
+	return m_Commands.TryPush(std::move(command));
+}
+
+bool RenderThread::Submit(const GameSnapshot& snapshot)
+{
+	//A full queue means the renderer is behind; it will pick up a newer snapshot instead
+	return m_Snapshots.TryPush(snapshot);
+}
+
+bool RenderThread::HasFailed() const
+{
+	return m_Failed;
+}
+
+void RenderThread::Run()
+{
+	glfwMakeContextCurrent(m_Window);
+
+	// glad: load all OpenGL function pointers
+	// ---------------------------------------
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cout << "Failed to initialize GLAD" << std::endl;
+		m_Failed = true;
+		glfwMakeContextCurrent(NULL);
+		return;
+	}
+	GLExtensions::Load((GLADloadproc)glfwGetProcAddress);
+
+	std::cout << glGetString(GL_VERSION) << std::endl;
+
+	//The swap paces this thread; without vsync it would spin drawing the same snapshot
+	glfwSwapInterval(1);
+
+	{
+		Renderer renderer(m_FramebufferWidth, m_FramebufferHeight);
+
+		GameSnapshot previous;
+		GameSnapshot current;
+		LatencyStats latency;
+		bool trackLatency = false;
+		std::chrono::steady_clock::time_point nextLatencyReport;
+
+		while (m_Running)
+		{
+			RenderCommand command;
+			while (m_Commands.TryPop(command))
+			{
+				if (command.type == RenderCommand::TRACK_LATENCY)
+				{
+					trackLatency = command.enabled;
+					latency.Clear();
+					nextLatencyReport = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+				}
+				else
+				{
+					renderer.Execute(command);
+				}
+			}
+
+			//Only the two newest ticks are kept, but the oldest input among the skipped ones is what this frame answers.
+			//A snapshot sent for input between ticks replaces the current tick instead of shifting it out.
+			std::chrono::steady_clock::time_point inputTime;
+			GameSnapshot next;
+			while (m_Snapshots.TryPop(next))
+			{
+				if (inputTime == std::chrono::steady_clock::time_point())
+					inputTime = next.inputTime;
+				if (next.tick != current.tick)
+					previous = current;
+				current = next;
+			}
+
+			//Draw one tick in the past so there is always a later state to blend towards
+			double alpha = 1.0;
+			if (current.tick != previous.tick)
+			{
+				const std::chrono::steady_clock::time_point drawTime = std::chrono::steady_clock::now() - GameClock::STEP;
+				alpha = std::chrono::duration<double>(drawTime - previous.tickTime) / (current.tickTime - previous.tickTime);
+				alpha = std::min(std::max(alpha, 0.0), 1.0);
+			}
+
+			renderer.Draw(GameSnapshot::Interpolate(previous, current, alpha));
+			renderer.EndFrame();
+
+			glfwSwapBuffers(m_Window);
+
+			if (trackLatency && inputTime != std::chrono::steady_clock::time_point())
+			{
+				//Wait for the swap to really happen; only in this mode, since it costs the CPU/GPU overlap
+				glFinish();
+				latency.Add(inputTime, std::chrono::steady_clock::now());
+			}
+
+			if (trackLatency && std::chrono::steady_clock::now() >= nextLatencyReport)
+			{
+				const LatencyStats::Summary summary = latency.Summarize();
+				if (summary.samples > 0)
+				{
+					std::cout << "INPUT TO PRESENT (ms, " << summary.samples << " samples): min " << summary.minimum
+						<< " avg " << summary.average << " p99 " << summary.p99 << " max " << summary.maximum << std::endl;
+				}
+				nextLatencyReport += std::chrono::seconds(2);
+			}
+		}
+	}
+
+	glfwMakeContextCurrent(NULL);
+}
@@ -0,0 +1,41 @@
+#ifndef RENDER_THREAD_CLASS
+#define RENDER_THREAD_CLASS
+#include <atomic>
+#include <thread>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "GameSnapshot.h"
+#include "RenderCommand.h"
+#include "SpscQueue.h"
+
+//Owns the window's GL context and renders on its own thread, so a swap that waits for vsync
+//never holds up input handling or the simulation. The main thread talks to it only through
+//two lock-free queues: commands, which are all executed, and snapshots, of which the renderer
+//draws the newest one each frame.
+class RenderThread
+{
+private:
+	GLFWwindow* m_Window;
+	int m_FramebufferWidth;
+	int m_FramebufferHeight;
+	std::thread m_Thread;
+	std::atomic<bool> m_Running;
+	std::atomic<bool> m_Failed;
+	SpscQueue<RenderCommand, 64> m_Commands;
+	//A 240 Hz simulation queues about four per 60 Hz frame
+	SpscQueue<GameSnapshot, 16> m_Snapshots;
+public:
+	//The window's context must not be current on the calling thread. GLFW only allows
+	//querying the framebuffer size on the main thread, so it is passed in.
+	RenderThread(GLFWwindow* window, int framebufferWidth, int framebufferHeight);
+	//Stops and joins the thread, which destroys every GL resource while its context is still alive
+	~RenderThread();
+	//Main thread only. Return false when the queue is full.
+	bool Submit(RenderCommand command);
+	bool Submit(const GameSnapshot& snapshot);
+	//True when the GL context could not be set up
+	bool HasFailed() const;
+private:
+	void Run();
+};
+#endif
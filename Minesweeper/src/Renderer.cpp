@@ -0,0 +1,205 @@
+#include "Renderer.h"
+#include <iostream>
+#include <stb_image/stb_image.h>
+#include "GLCounters.h"
+#include "Hud.h"
+#include "TileShader.h"
+#include "generated/EmbeddedShaders.h"
+
+namespace
+{
+	//Location of the time uniform in res/shaders/tile/vertex.shader
+	const int TIME_UNIFORM_LOCATION = 0;
+	//Below this many pixels per cell the board is drawn from the overview pyramid
+	const double OVERVIEW_ZOOM = 1.0;
+}
+
+//SHADER GENERATION comes first so the driver compiles while the buffers and textures are set up
+Renderer::Renderer(const int framebufferWidth, const int framebufferHeight)
+	: m_FlatShader(TileShader::Get(m_Shaders, TileShader::FLAT)),
+	  m_TexturedShader(TileShader::Get(m_Shaders, TileShader::TEXTURED | TileShader::ANIMATED)),
+	  m_HighlightedShader(TileShader::Get(m_Shaders, TileShader::TEXTURED | TileShader::ANIMATED | TileShader::HOVER_HIGHLIGHT)),
+	  m_OverviewShader(m_Shaders.Get(EmbeddedShaders::OverviewVertex, EmbeddedShaders::OverviewFragment)),
+	  m_CachedShader(TileShader::Get(m_Shaders, TileShader::TEXTURED)),
+	  m_CachedHighlightedShader(TileShader::Get(m_Shaders, TileShader::TEXTURED | TileShader::HOVER_HIGHLIGHT)),
+	  m_CompositeShader(m_Shaders.Get(EmbeddedShaders::OverviewVertex, EmbeddedShaders::CompositeFragment)),
+	  m_SpriteShader(m_Shaders.Get(EmbeddedShaders::SpriteVertex, EmbeddedShaders::SpriteFragment)),
+	  m_TextShader(m_Shaders.Get(EmbeddedShaders::SpriteVertex, EmbeddedShaders::TextFragment)),
+	  m_CacheBoard(false),
+	  m_CachedHighlighted(false),
+	  m_Sprites(m_SpriteShader),
+	  m_Text(m_TextShader),
+	  m_GpuTimer(PerfOverlay::PASS_COUNT),
+	  m_ShowPerf(false),
+	  m_LastFrame(std::chrono::steady_clock::now()),
+	  m_Width(framebufferWidth),
+	  m_Height(framebufferHeight),
+	  m_Capture(framebufferWidth, framebufferHeight)
+{
+	//TEXTURE GENERATION
+	m_Texture = LoadTexture("res/texture/brick.png");
+
+	glViewport(0, 0, framebufferWidth, framebufferHeight);
+}
+
+Renderer::~Renderer()
+{
+	glDeleteTextures(1, &m_Texture);
+}
+
+unsigned int Renderer::LoadTexture(const char* filePath) const
+{
+	int width, height, colorChannel;
+
+	unsigned char* data = stbi_load(filePath, &width, &height, &colorChannel, 4);
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	if (data)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		glGenerateMipmap(GL_TEXTURE_2D);
+	}
+	else
+	{
+		std::cout << "ERROR LOADING TEXTURE AT " << filePath << std::endl;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	stbi_image_free(data);
+	return texture;
+}
+
+void Renderer::Execute(const RenderCommand& command)
+{
+	switch (command.type)
+	{
+	case RenderCommand::RESIZE:
+		glViewport(0, 0, command.width, command.height);
+		m_Width = command.width;
+		m_Height = command.height;
+		m_Capture.Resize(command.width, command.height);
+		break;
+	case RenderCommand::SCREENSHOT:
+		m_Capture.Screenshot(command.path);
+		break;
+	case RenderCommand::START_RECORDING:
+		m_Capture.StartRecording(command.path);
+		break;
+	case RenderCommand::STOP_RECORDING:
+		m_Capture.StopRecording();
+		break;
+	case RenderCommand::TRACK_LATENCY:
+		//Handled by RenderThread, which owns the swap
+		break;
+	case RenderCommand::NEW_BOARD:
+		m_Board.Reset(command.width, command.height, command.topology, glm::i64vec2(command.originX, command.originY));
+		m_Cache.Reset(command.width, command.height);
+		break;
+	case RenderCommand::REVEAL:
+		m_Board.Reveal(command.reveals);
+		m_Cache.Invalidate(command.reveals);
+		break;
+	case RenderCommand::PERF_OVERLAY:
+		m_ShowPerf = command.enabled;
+		break;
+	case RenderCommand::CACHE_BOARD:
+		m_CacheBoard = command.enabled;
+		m_Cache.InvalidateAll();
+		break;
+	}
+}
+
+void Renderer::Draw(const GameSnapshot& snapshot)
+{
+	const std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+	PerfOverlay::FrameStats stats;
+	stats.frameMilliseconds = std::chrono::duration<float, std::milli>(frameStart - m_LastFrame).count();
+	m_LastFrame = frameStart;
+	m_GpuTimer.BeginFrame();
+
+	m_Shaders.HotReload();
+
+	glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	m_GpuTimer.Begin(PerfOverlay::BOARD_PASS);
+	DrawBoard(snapshot);
+	m_GpuTimer.End(PerfOverlay::BOARD_PASS);
+	const std::chrono::steady_clock::time_point boardEnd = std::chrono::steady_clock::now();
+
+	//HUD on top, one batch for the whole frame
+	m_GpuTimer.Begin(PerfOverlay::HUD_PASS);
+	m_Sprites.Begin(m_Width, m_Height);
+	Hud::Draw(m_Sprites, m_Text, snapshot, m_Width);
+	if (m_ShowPerf)
+		m_Perf.Draw(m_Sprites, m_Text, 8.0f, Hud::BAR_HEIGHT + 8.0f);
+	m_Sprites.End();
+	m_GpuTimer.End(PerfOverlay::HUD_PASS);
+	const std::chrono::steady_clock::time_point hudEnd = std::chrono::steady_clock::now();
+
+	//STATS of this frame, shown from the next one on
+	stats.cpuMilliseconds[PerfOverlay::BOARD_PASS] = std::chrono::duration<float, std::milli>(boardEnd - frameStart).count();
+	stats.cpuMilliseconds[PerfOverlay::HUD_PASS] = std::chrono::duration<float, std::milli>(hudEnd - boardEnd).count();
+	for (int pass = 0; pass < PerfOverlay::PASS_COUNT; pass++)
+		stats.gpuMilliseconds[pass] = static_cast<float>(m_GpuTimer.Milliseconds(pass));
+	const GLCounters counters = GLCounters::Take();
+	stats.drawCalls = counters.drawCalls;
+	stats.elidedCalls = counters.elidedCalls;
+	stats.uploadBytes = counters.uploadBytes;
+	stats.revealMilliseconds = snapshot.revealMilliseconds;
+	stats.solverMilliseconds = snapshot.solverMilliseconds;
+	stats.hintHits = snapshot.hintHits;
+	stats.hintMisses = snapshot.hintMisses;
+	m_Perf.Record(stats);
+}
+
+void Renderer::DrawBoard(const GameSnapshot& snapshot)
+{
+	//The board's cells are counted from its origin, the camera's from the world's
+	const Camera camera = snapshot.camera.Relative(m_Board.Origin());
+
+	//The overview and the cache have a texel per cell, which only lines up with square cells
+	const bool squareCells = m_Board.Topology() == GridTopology::SQUARE || m_Board.Topology() == GridTopology::TORUS;
+
+	//Zoomed out far enough that tiles would be sub-pixel: one quad from the pyramid instead of a tile per cell
+	if (squareCells && camera.Zoom() < OVERVIEW_ZOOM)
+	{
+		m_OverviewShader.Activate();
+		m_Board.DrawOverview(m_OverviewShader, camera);
+		return;
+	}
+
+	//ourTexture is bound to unit 0 in the shader itself
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+
+	//The cache's chunks are cleared with the clear color set in Draw
+	if (m_CacheBoard && squareCells)
+	{
+		if (snapshot.highlighted != m_CachedHighlighted)
+		{
+			m_CachedHighlighted = snapshot.highlighted;
+			m_Cache.InvalidateAll();
+		}
+		const ShaderProgram& cachedShader = snapshot.highlighted ? m_CachedHighlightedShader : m_CachedShader;
+		m_Cache.Draw(m_Board, cachedShader, m_CompositeShader, camera, static_cast<float>(snapshot.time));
+		return;
+	}
+
+	const ShaderProgram& shader = snapshot.highlighted ? m_HighlightedShader : m_TexturedShader;
+	shader.Activate();
+	shader.Set1f(TIME_UNIFORM_LOCATION, static_cast<float>(snapshot.time));
+	m_Board.Draw(shader, camera);
+}
+
+void Renderer::EndFrame()
+{
+	m_Capture.EndFrame();
+}
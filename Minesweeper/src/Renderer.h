@@ -0,0 +1,60 @@
+#ifndef RENDERER_CLASS
+#define RENDERER_CLASS
+#include <chrono>
+#include "BoardCache.h"
+#include "BoardRenderer.h"
+#include "FrameCapture.h"
+#include "GameSnapshot.h"
+#include "GpuTimer.h"
+#include "PerfOverlay.h"
+#include "RenderCommand.h"
+#include "ShaderLibrary.h"
+#include "ShaderProgram.h"
+#include "SpriteBatch.h"
+#include "TextRenderer.h"
+
+//All GL resources of the game. Lives on the render thread and must be created and
+//destroyed there, with the window's context current.
+class Renderer
+{
+private:
+	ShaderLibrary m_Shaders;
+	const ShaderProgram& m_FlatShader;
+	const ShaderProgram& m_TexturedShader;
+	const ShaderProgram& m_HighlightedShader;
+	const ShaderProgram& m_OverviewShader;
+	//Without the per-frame pulse, for drawing into BoardCache
+	const ShaderProgram& m_CachedShader;
+	const ShaderProgram& m_CachedHighlightedShader;
+	const ShaderProgram& m_CompositeShader;
+	const ShaderProgram& m_SpriteShader;
+	const ShaderProgram& m_TextShader;
+
+	BoardRenderer m_Board;
+	BoardCache m_Cache;
+	bool m_CacheBoard;
+	//Tile variant the cache was drawn with, to redraw it all when that changes
+	bool m_CachedHighlighted;
+	unsigned int m_Texture;
+	SpriteBatch m_Sprites;
+	TextRenderer m_Text;
+	PerfOverlay m_Perf;
+	GpuTimer m_GpuTimer;
+	bool m_ShowPerf;
+	std::chrono::steady_clock::time_point m_LastFrame;
+	int m_Width;
+	int m_Height;
+
+	FrameCapture m_Capture;
+public:
+	Renderer(int framebufferWidth, int framebufferHeight);
+	~Renderer();
+	void Execute(const RenderCommand& command);
+	void Draw(const GameSnapshot& snapshot);
+	//Call right before swapping buffers
+	void EndFrame();
+private:
+	unsigned int LoadTexture(const char* filePath) const;
+	void DrawBoard(const GameSnapshot& snapshot);
+};
+#endif
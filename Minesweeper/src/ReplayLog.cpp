@@ -0,0 +1,29 @@
+#include "ReplayLog.h"
+
+ReplayLog::ReplayLog()
+	: m_Columns(0), m_Rows(0), m_Mines(0), m_Seed(0), m_LastTick(0)
+{
+}
+
+void ReplayLog::Start(const int columns, const int rows, const size_t mines, const uint64_t seed)
+{
+	m_Columns = columns;
+	m_Rows = rows;
+	m_Mines = mines;
+	m_Seed = seed;
+	m_Moves.clear();
+	m_Checksums.clear();
+	m_LastTick = 0;
+}
+
+void ReplayLog::RecordMove(const uint64_t tick, const MoveType type, const int column, const int row)
+{
+	m_Moves.push_back(Move{ tick, type, column, row });
+}
+
+void ReplayLog::RecordTick(const uint64_t tick, const uint64_t hash)
+{
+	if (m_Checksums.empty() || m_Checksums.back().hash != hash)
+		m_Checksums.push_back(Checksum{ tick, hash });
+	m_LastTick = tick;
+}
@@ -0,0 +1,115 @@
+#ifndef REPLAY_LOG_CLASS
+#define REPLAY_LOG_CLASS
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BoardHistory.h"
+#include "CellReveal.h"
+
+//Everything needed to play a fixed-board game again: its parameters, every move with the tick it
+//was made on, and a checksum of the board (BasicBoard::Hash) for every tick. Checksums are stored
+//only when they change, each covering the ticks up to the next, so a long game with few moves
+//stays small. Replaying the moves on a fresh board must match the covering checksum on the tick
+//after every move and wherever a checksum starts; the first tick where it does not is where the
+//two diverged.
+class ReplayLog
+{
+public:
+	enum MoveType : uint8_t
+	{
+		//Reveals a hidden cell or chords a revealed one, like a left click
+		REVEAL,
+		FLAG,
+		UNDO,
+		REDO
+	};
+
+	struct Move
+	{
+		//Made during this tick, after its checksum
+		uint64_t tick;
+		MoveType type;
+		int column;
+		int row;
+	};
+
+	struct Checksum
+	{
+		//First tick with this hash
+		uint64_t tick;
+		uint64_t hash;
+	};
+private:
+	int m_Columns;
+	int m_Rows;
+	size_t m_Mines;
+	uint64_t m_Seed;
+	std::vector<Move> m_Moves;
+	std::vector<Checksum> m_Checksums;
+	//The last tick RecordTick was called for; moves after it are not covered by a checksum yet
+	uint64_t m_LastTick;
+public:
+	ReplayLog();
+	//Forgets the last game and starts logging a new one
+	void Start(int columns, int rows, size_t mines, uint64_t seed);
+	void RecordMove(uint64_t tick, MoveType type, int column = 0, int row = 0);
+	//The board's hash as of tick, at the latest on the tick after any moves; ticks not recorded have
+	//the hash of the one before
+	void RecordTick(uint64_t tick, uint64_t hash);
+
+	size_t MoveCount() const { return m_Moves.size(); }
+	size_t ChecksumCount() const { return m_Checksums.size(); }
+
+	//Plays the game again on a fresh BoardType and returns the first tick whose covering checksum
+	//it does not match, or -1 when it matches all of them
+	template <typename BoardType>
+	int64_t FirstDesync() const
+	{
+		BoardType board;
+		BoardHistory<BoardType> history;
+		board.Reset(m_Columns, m_Rows, m_Mines, m_Seed);
+		history.Reset(board);
+		std::vector<CellReveal> reveals;
+
+		//next is the first move not played yet, upcoming the first checksum not reached yet
+		size_t next = 0;
+		size_t upcoming = 0;
+		while (next < m_Moves.size() || upcoming < m_Checksums.size())
+		{
+			//Checked: the tick after each move's, where its effect is first recorded, and each tick a checksum starts
+			uint64_t tick = UINT64_MAX;
+			if (next < m_Moves.size())
+				tick = m_Moves[next].tick + 1;
+			if (upcoming < m_Checksums.size())
+				tick = std::min(tick, m_Checksums[upcoming].tick);
+			if (m_Checksums.empty() || tick > m_LastTick)
+				break;
+
+			for (; next < m_Moves.size() && m_Moves[next].tick < tick; next++)
+			{
+				const Move& move = m_Moves[next];
+				reveals.clear();
+				bool moved = false;
+				if (move.type == REVEAL)
+					moved = board.IsRevealed(move.column, move.row) ? board.Chord(move.column, move.row, 0.0f, reveals)
+					                                                : board.Reveal(move.column, move.row, 0.0f, reveals);
+				else if (move.type == FLAG)
+					moved = board.ToggleFlag(move.column, move.row, reveals);
+				else if (move.type == UNDO)
+					history.Undo(board, 0.0f, reveals);
+				else
+					history.Redo(board, 0.0f, reveals);
+				if (moved)
+					history.Record(board);
+			}
+			while (upcoming < m_Checksums.size() && m_Checksums[upcoming].tick <= tick)
+				upcoming++;
+			//Moves from before the first checksum have nothing to check against until it starts
+			if (upcoming > 0 && board.Hash() != m_Checksums[upcoming - 1].hash)
+				return static_cast<int64_t>(tick);
+		}
+		return -1;
+	}
+};
+#endif
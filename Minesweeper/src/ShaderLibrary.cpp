@@ -0,0 +1,63 @@
+#include "ShaderLibrary.h"
+#include "GLExtensions.h"
+
+ShaderLibrary::ShaderLibrary()
+{
+#ifdef SHADER_HOT_RELOAD
+	m_UseSpirv = false;
+#else
+	m_UseSpirv = GLExtensions::HasSpirvShaders();
+#endif
+
+	//0xFFFFFFFF is the spec's value for "implementation defined maximum"
+	if (GLExtensions::HasParallelShaderCompile())
+		GLExtensions::MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+}
+
+const ShaderProgram& ShaderLibrary::Get(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines)
+{
+	const uint64_t key = ShaderProgram::MakeKey(vertexShader, fragmentShader, defines);
+
+	std::unique_ptr<ShaderProgram>& program = m_Programs[key];
+	if (!program)
+		program = std::make_unique<ShaderProgram>(vertexShader, fragmentShader, defines);
+	return *program;
+}
+
+const ShaderProgram& ShaderLibrary::GetSpecialized(const SpirvSource& vertexModule, const SpirvSource& fragmentModule, const SpecializationConstants& constants,
+                                                   const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines)
+{
+	if (!m_UseSpirv || vertexModule.wordCount == 0 || fragmentModule.wordCount == 0)
+		return Get(vertexShader, fragmentShader, defines);
+
+	const uint64_t key = ShaderProgram::MakeKey(vertexModule, fragmentModule, constants);
+
+	std::unique_ptr<ShaderProgram>& program = m_Programs[key];
+	if (!program)
+		program = std::make_unique<ShaderProgram>(vertexModule, fragmentModule, constants);
+	return *program;
+}
+
+size_t ShaderLibrary::PendingCount() const
+{
+	size_t pending = 0;
+	for (const auto& [key, program] : m_Programs)
+	{
+		if (!program->IsReady())
+			pending++;
+	}
+	return pending;
+}
+
+void ShaderLibrary::HotReload()
+{
+#ifdef SHADER_HOT_RELOAD
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now < m_NextReloadCheck)
+		return;
+	m_NextReloadCheck = now + std::chrono::milliseconds(250);
+
+	for (auto& [key, program] : m_Programs)
+		program->ReloadIfChanged();
+#endif
+}
@@ -0,0 +1,36 @@
+#ifndef SHADER_LIBRARY_CLASS
+#define SHADER_LIBRARY_CLASS
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "ShaderPreprocessor.h"
+#include "ShaderProgram.h"
+#include "ShaderSource.h"
+
+//Owns every linked program, keyed by the combined hash of its sources and variant defines,
+//so asking for the same vertex/fragment/defines combination twice only builds it once.
+//Get only submits the build, so asking for every program up front lets the driver
+//compile them all in parallel; a program only blocks the first time it is activated.
+class ShaderLibrary
+{
+private:
+	std::unordered_map<uint64_t, std::unique_ptr<ShaderProgram>> m_Programs;
+	std::chrono::steady_clock::time_point m_NextReloadCheck;
+	bool m_UseSpirv;
+public:
+	//Lets the driver use as many compiler threads as it likes. Needs a current GL context.
+	ShaderLibrary();
+	//Returns the cached variant, building it on first request
+	const ShaderProgram& Get(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines = ShaderDefines());
+	//Loads the SPIR-V modules when the driver supports them and they were built, otherwise
+	//compiles the GLSL fallback. Hot reload builds always use GLSL so edits still show up.
+	const ShaderProgram& GetSpecialized(const SpirvSource& vertexModule, const SpirvSource& fragmentModule, const SpecializationConstants& constants,
+	                                    const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines);
+	//Number of programs the driver is still building. Never blocks, useful for a loading screen.
+	size_t PendingCount() const;
+	//Checks the shader files of every program for changes a few times a second.
+	//Cheap enough to call every frame; does nothing in release builds.
+	void HotReload();
+};
+#endif
@@ -0,0 +1,166 @@
+#include "ShaderPreprocessor.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "generated/EmbeddedShaders.h"
+
+ShaderDefines& ShaderDefines::Define(const std::string_view name)
+{
+	m_Text.append("#define ").append(name).append("\n");
+	return *this;
+}
+
+ShaderDefines& ShaderDefines::Define(const std::string_view name, const int value)
+{
+	m_Text.append("#define ").append(name).append(" ").append(std::to_string(value)).append("\n");
+	return *this;
+}
+
+ShaderDefines& ShaderDefines::Define(const std::string_view name, const float value)
+{
+	m_Text.append("#define ").append(name).append(" ").append(std::to_string(value)).append("\n");
+	return *this;
+}
+
+std::string_view ShaderDefines::Text() const
+{
+	return m_Text;
+}
+
+uint64_t ShaderDefines::Hash() const
+{
+	return HashShaderSource(m_Text);
+}
+
+namespace
+{
+	//"res/shaders/tile/vertex.shader" + "../common/noise.glsl" -> "res/shaders/common/noise.glsl"
+	std::string ResolveInclude(const std::string_view includer, const std::string_view included)
+	{
+		std::vector<std::string> parts;
+		std::string path(includer.substr(0, includer.find_last_of('/') + 1));
+		path.append(included);
+
+		std::stringstream stream(path);
+		std::string part;
+		while (std::getline(stream, part, '/'))
+		{
+			if (part == "..")
+			{
+				if (!parts.empty())
+					parts.pop_back();
+			}
+			else if (!part.empty() && part != ".")
+				parts.push_back(part);
+		}
+
+		std::string resolved;
+		for (const std::string& piece : parts)
+			resolved.append(resolved.empty() ? "" : "/").append(piece);
+		return resolved;
+	}
+
+	bool LoadInclude(const std::string& name, const bool fromDisk, std::string& code)
+	{
+		if (fromDisk)
+		{
+			std::ifstream file(name);
+			if (file)
+			{
+				std::stringstream stream;
+				stream << file.rdbuf();
+				code = stream.str();
+				return true;
+			}
+		}
+
+		for (const ShaderSource& source : EmbeddedShaders::All)
+		{
+			if (source.name == name)
+			{
+				code = source.code;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Expand(const std::string_view name, const std::string_view code, const bool fromDisk, std::vector<std::string>& included, std::string& result)
+	{
+		size_t lineStart = 0;
+		while (lineStart < code.size())
+		{
+			size_t lineEnd = code.find('\n', lineStart);
+			lineEnd = lineEnd == std::string_view::npos ? code.size() : lineEnd + 1;
+			const std::string_view line = code.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd;
+
+			const size_t directive = line.find_first_not_of(" \t");
+			if (directive == std::string_view::npos || line.compare(directive, 8, "#include") != 0)
+			{
+				result.append(line);
+				continue;
+			}
+
+			const size_t open = line.find('"');
+			const size_t close = open == std::string_view::npos ? open : line.find('"', open + 1);
+			if (close == std::string_view::npos)
+			{
+				std::cout << "SHADER_INCLUDE_ERROR in " << name << ": " << line << std::endl;
+				continue;
+			}
+
+			const std::string includeName = ResolveInclude(name, line.substr(open + 1, close - open - 1));
+			if (std::find(included.begin(), included.end(), includeName) != included.end())
+				continue;
+
+			std::string includeCode;
+			if (!LoadInclude(includeName, fromDisk, includeCode))
+			{
+				std::cout << "SHADER_INCLUDE_ERROR in " << name << ": could not find " << includeName << std::endl;
+				continue;
+			}
+
+			included.push_back(includeName);
+			Expand(includeName, includeCode, fromDisk, included, result);
+			if (!result.empty() && result.back() != '\n')
+				result.push_back('\n');
+		}
+	}
+}
+
+namespace ShaderPreprocessor
+{
+	std::string Process(const ShaderSource& source, const std::string_view defines, const bool fromDisk, std::vector<std::string>& files)
+	{
+		return Process(source.name, source.code, defines, fromDisk, files);
+	}
+
+	std::string Process(const std::string_view name, const std::string_view code, const std::string_view defines, const bool fromDisk, std::vector<std::string>& files)
+	{
+		//Each stage tracks its own includes; the vertex and fragment shader both need common code
+		std::vector<std::string> included{ std::string(name) };
+
+		std::string result;
+		result.reserve(code.size() + defines.size());
+		Expand(name, code, fromDisk, included, result);
+		files.insert(files.end(), included.begin(), included.end());
+
+		if (defines.empty())
+			return result;
+
+		size_t version = result.find("#version");
+		if (version == std::string::npos)
+			return std::string(defines) + result;
+
+		size_t afterVersion = result.find('\n', version);
+		if (afterVersion == std::string::npos)
+		{
+			result.push_back('\n');
+			afterVersion = result.size() - 1;
+		}
+		result.insert(afterVersion + 1, defines);
+		return result;
+	}
+}
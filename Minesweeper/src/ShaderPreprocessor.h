@@ -0,0 +1,33 @@
+#ifndef SHADER_PREPROCESSOR_CLASS
+#define SHADER_PREPROCESSOR_CLASS
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ShaderSource.h"
+
+//The #define block that selects a shader variant, e.g. ShaderDefines().Define("TEXTURED").
+//Two variants are the same program exactly when their define text is the same.
+class ShaderDefines
+{
+private:
+	std::string m_Text;
+public:
+	ShaderDefines& Define(std::string_view name);
+	ShaderDefines& Define(std::string_view name, int value);
+	ShaderDefines& Define(std::string_view name, float value);
+	std::string_view Text() const;
+	uint64_t Hash() const;
+};
+
+namespace ShaderPreprocessor
+{
+	//Expands #include "file" (paths relative to the including shader, each file included once)
+	//and injects the defines right after the #version line, since GLSL requires #version first.
+	//Includes come from the embedded shaders, or from disk first when fromDisk is set (hot reload).
+	//Every file that went into the result is appended to files.
+	std::string Process(const ShaderSource& source, std::string_view defines, bool fromDisk, std::vector<std::string>& files);
+	//Same, but for code that was just read from the file called name
+	std::string Process(std::string_view name, std::string_view code, std::string_view defines, bool fromDisk, std::vector<std::string>& files);
+}
+#endif
@@ -1,45 +1,155 @@
 ﻿#include "ShaderProgram.h"
+#include "GLCounters.h"
+#include "GLExtensions.h"
 
 ShaderProgram::ShaderProgram(const char* vertexShaderFilePath, const char* fragmentShaderFilePath)
 {
 	//GET FILE CONTENTS
-	const std::string vertexShaderString = GetFileContents(vertexShaderFilePath);
-	const std::string fragmentShaderString = GetFileContents(fragmentShaderFilePath);
+	std::vector<std::string> files;
+	const std::string vertexShaderString = ShaderPreprocessor::Process(vertexShaderFilePath, GetFileContents(vertexShaderFilePath), "", true, files);
+	const std::string fragmentShaderString = ShaderPreprocessor::Process(fragmentShaderFilePath, GetFileContents(fragmentShaderFilePath), "", true, files);
 
-	const char* vertexShaderCode = vertexShaderString.c_str();
-	const char* fragmentShaderCode = fragmentShaderString.c_str();
+	m_Key = CombineShaderHashes(HashShaderSource(vertexShaderString), HashShaderSource(fragmentShaderString));
+
+	m_Id = Submit(vertexShaderString, fragmentShaderString, m_PendingVertexShader, m_PendingFragmentShader);
+	m_Pending = true;
+
+#ifdef SHADER_HOT_RELOAD
+	m_VertexPath = vertexShaderFilePath;
+	m_FragmentPath = fragmentShaderFilePath;
+	Watch(files);
+#endif
+}
+
+ShaderProgram::ShaderProgram(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines)
+{
+	m_Key = MakeKey(vertexShader, fragmentShader, defines);
+
+	//VARIANT PREPROCESSING
+	std::vector<std::string> files;
+	const std::string vertexShaderString = ShaderPreprocessor::Process(vertexShader, defines.Text(), false, files);
+	const std::string fragmentShaderString = ShaderPreprocessor::Process(fragmentShader, defines.Text(), false, files);
+
+	m_Id = Submit(vertexShaderString, fragmentShaderString, m_PendingVertexShader, m_PendingFragmentShader);
+	m_Pending = true;
+
+#ifdef SHADER_HOT_RELOAD
+	m_VertexPath = vertexShader.name;
+	m_FragmentPath = fragmentShader.name;
+	m_Defines = defines.Text();
+	Watch(files);
+#endif
+}
+
+ShaderProgram::ShaderProgram(const SpirvSource& vertexShader, const SpirvSource& fragmentShader, const SpecializationConstants& constants)
+{
+	m_Key = MakeKey(vertexShader, fragmentShader, constants);
+
+	m_Id = SubmitSpirv(vertexShader, fragmentShader, constants, m_PendingVertexShader, m_PendingFragmentShader);
+	m_Pending = true;
+}
+
+uint64_t ShaderProgram::MakeKey(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines)
+{
+	return CombineShaderHashes(CombineShaderHashes(vertexShader.hash, fragmentShader.hash), defines.Hash());
+}
+
+uint64_t ShaderProgram::MakeKey(const SpirvSource& vertexShader, const SpirvSource& fragmentShader, const SpecializationConstants& constants)
+{
+	return CombineShaderHashes(CombineShaderHashes(vertexShader.hash, fragmentShader.hash), constants.Hash());
+}
+
+//Hands everything to the driver without asking for the result. Querying compile or link status
+//forces the driver to finish right away, so that is left to Finish, which runs on first use.
+unsigned int ShaderProgram::Submit(const std::string_view vertexShaderCode, const std::string_view fragmentShaderCode,
+                                   unsigned int& vertexShader, unsigned int& fragmentShader) const
+{
+	//Embedded sources are not null terminated, so pass the lengths along
+	const char* vertexShaderData = vertexShaderCode.data();
+	const char* fragmentShaderData = fragmentShaderCode.data();
+	const GLint vertexShaderLength = static_cast<GLint>(vertexShaderCode.size());
+	const GLint fragmentShaderLength = static_cast<GLint>(fragmentShaderCode.size());
 
 	//CREATE THE SHADERS
-	const unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	const unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
 
 	//PUSH CODE INTO THE CREATED SHADERS
-	glShaderSource(vertexShader, 1, &vertexShaderCode, NULL);
-	glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL);
+	glShaderSource(vertexShader, 1, &vertexShaderData, &vertexShaderLength);
+	glShaderSource(fragmentShader, 1, &fragmentShaderData, &fragmentShaderLength);
 
 	//COMPILE SHADERS
 	glCompileShader(vertexShader);
 	glCompileShader(fragmentShader);
 
-	//ERROR TESTING COMPILATION
-	CompileErrors(vertexShader, "VERTEX");
-	CompileErrors(fragmentShader, "FRAGMENT");
+	return Link(vertexShader, fragmentShader);
+}
+
+//The driver skips the GLSL front end entirely: the module is loaded as is and only specialized
+unsigned int ShaderProgram::SubmitSpirv(const SpirvSource& vertexShaderModule, const SpirvSource& fragmentShaderModule, const SpecializationConstants& constants,
+                                        unsigned int& vertexShader, unsigned int& fragmentShader) const
+{
+	//CREATE THE SHADERS
+	vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+
+	//LOAD THE MODULES
+	glShaderBinary(1, &vertexShader, GL_SHADER_BINARY_FORMAT_SPIR_V, vertexShaderModule.words, static_cast<GLsizei>(vertexShaderModule.wordCount * sizeof(uint32_t)));
+	glShaderBinary(1, &fragmentShader, GL_SHADER_BINARY_FORMAT_SPIR_V, fragmentShaderModule.words, static_cast<GLsizei>(fragmentShaderModule.wordCount * sizeof(uint32_t)));
 
+	//SPECIALIZE, constants the module does not declare are ignored
+	const GLuint count = static_cast<GLuint>(constants.Ids().size());
+	glSpecializeShader(vertexShader, "main", count, constants.Ids().data(), constants.Values().data());
+	glSpecializeShader(fragmentShader, "main", count, constants.Ids().data(), constants.Values().data());
+
+	return Link(vertexShader, fragmentShader);
+}
+
+unsigned int ShaderProgram::Link(const unsigned int vertexShader, const unsigned int fragmentShader) const
+{
 	//CREATE SHADER PROGRAM
-	m_Id = glCreateProgram();
+	const unsigned int program = glCreateProgram();
 
 	//ATTACH SHADERS
-	glAttachShader(m_Id, vertexShader);
-	glAttachShader(m_Id, fragmentShader);
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
 
 	//LINKING
-	glLinkProgram(m_Id);
+	glLinkProgram(program);
+	return program;
+}
+
+//Blocks until the driver is done with the program, then reports errors and frees the shader objects
+bool ShaderProgram::Finish(const unsigned int program, const unsigned int vertexShader, const unsigned int fragmentShader) const
+{
+	//ERROR TESTING COMPILATION
+	bool succeeded = !CompileErrors(vertexShader, "VERTEX");
+	succeeded = !CompileErrors(fragmentShader, "FRAGMENT") && succeeded;
 
 	//ERROR TESTING SHADER LINKING
-	CompileErrors(m_Id, "LINKING");
+	succeeded = !CompileErrors(program, "PROGRAM") && succeeded;
 
 	glDeleteShader(vertexShader);
 	glDeleteShader(fragmentShader);
+	return succeeded;
+}
+
+bool ShaderProgram::IsReady() const
+{
+	if (!m_Pending || !GLExtensions::HasParallelShaderCompile())
+		return true;
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(m_Id, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+void ShaderProgram::Resolve() const
+{
+	if (!m_Pending)
+		return;
+	Finish(m_Id, m_PendingVertexShader, m_PendingFragmentShader);
+	m_Pending = false;
 }
 
 void ShaderProgram::SetVector4f(const char* name, const glm::vec4 &value) const
@@ -56,24 +166,61 @@ void ShaderProgram::Set1i(const char* name, int value) const
 	glUniform1i(location, value);
 }
 
+void ShaderProgram::Set1f(const int location, const float value) const
+{
+	glUniform1f(location, value);
+}
+
+void ShaderProgram::Set1i(const int location, const int value) const
+{
+	glUniform1i(location, value);
+}
+
+void ShaderProgram::Set2i(const int location, const int x, const int y) const
+{
+	glUniform2i(location, x, y);
+}
+
+void ShaderProgram::Set2f(const int location, const float x, const float y) const
+{
+	glUniform2f(location, x, y);
+}
+
+void ShaderProgram::Set4f(const int location, const float x, const float y, const float z, const float w) const
+{
+	glUniform4f(location, x, y, z, w);
+}
+
+void ShaderProgram::SetMatrix4f(const int location, const glm::mat4& value) const
+{
+	glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
 ShaderProgram::~ShaderProgram()
 {
+	if (m_Pending)
+	{
+		glDeleteShader(m_PendingVertexShader);
+		glDeleteShader(m_PendingFragmentShader);
+	}
 	this->Delete();
 }
 
-void ShaderProgram::CompileErrors(const unsigned int shader, const char* type) const
+//Returns true if the shader failed to compile or the program failed to link
+bool ShaderProgram::CompileErrors(const unsigned int shader, const char* type) const
 {
 	// Stores status of compilation
 	GLint hasCompiled;
 	// Character array to store error message in
 	char infoLog[1024];
-	if (type != "PROGRAM")
+	if (std::string_view(type) != "PROGRAM")
 	{
 		glGetShaderiv(shader, GL_COMPILE_STATUS, &hasCompiled);
 		if (hasCompiled == GL_FALSE)
 		{
 			glGetShaderInfoLog(shader, 1024, NULL, infoLog);
 			std::cout << "SHADER_COMPILATION_ERROR for:" << type << "\n" << infoLog << std::endl;
+			return true;
 		}
 	}
 	else
@@ -83,8 +230,10 @@ void ShaderProgram::CompileErrors(const unsigned int shader, const char* type) c
 		{
 			glGetProgramInfoLog(shader, 1024, NULL, infoLog);
 			std::cout << "SHADER_LINKING_ERROR for:" << type << "\n" << infoLog << std::endl;
+			return true;
 		}
 	}
+	return false;
 }
 
 std::string ShaderProgram::GetFileContents(const char* path) const
@@ -96,12 +245,77 @@ std::string ShaderProgram::GetFileContents(const char* path) const
 	return shaderStream.str();
 }
 
+namespace
+{
+	//Program last passed to glUseProgram on this thread, so switching to it again can be skipped
+	thread_local unsigned int activeProgram = 0;
+}
+
 void ShaderProgram::Delete() const
 {
+	//The name may be handed out again for a different program
+	if (activeProgram == m_Id)
+		activeProgram = 0;
 	glDeleteProgram(m_Id);
 }
 
 void ShaderProgram::Activate() const
 {
+	Resolve();
+	if (activeProgram == m_Id)
+	{
+		GLCounters::Current().elidedCalls++;
+		return;
+	}
 	glUseProgram(m_Id);
+	activeProgram = m_Id;
+}
+
+#ifdef SHADER_HOT_RELOAD
+void ShaderProgram::Watch(const std::vector<std::string>& files)
+{
+	m_WatchedFiles.clear();
+	for (const std::string& file : files)
+		m_WatchedFiles.emplace_back(file, LastWriteTime(file));
+}
+
+std::filesystem::file_time_type ShaderProgram::LastWriteTime(const std::string& path) const
+{
+	//Missing files (e.g. running outside the project directory) just never trigger a reload
+	std::error_code error;
+	const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+	return error ? std::filesystem::file_time_type::min() : time;
+}
+
+bool ShaderProgram::ReloadIfChanged()
+{
+	bool changed = false;
+	for (const auto& [file, writeTime] : m_WatchedFiles)
+		changed = changed || LastWriteTime(file) != writeTime;
+	if (!changed)
+		return false;
+
+	//Includes may have been added or removed, so the watch list is rebuilt from this pass
+	std::vector<std::string> files;
+	const std::string vertexShaderString = ShaderPreprocessor::Process(m_VertexPath, GetFileContents(m_VertexPath.c_str()), m_Defines, true, files);
+	const std::string fragmentShaderString = ShaderPreprocessor::Process(m_FragmentPath, GetFileContents(m_FragmentPath.c_str()), m_Defines, true, files);
+	Watch(files);
+
+	//Finish any pending build of the old program first so its shader objects are released
+	Resolve();
+
+	unsigned int vertexShader, fragmentShader;
+	const unsigned int program = Submit(vertexShaderString, fragmentShaderString, vertexShader, fragmentShader);
+	if (!Finish(program, vertexShader, fragmentShader))
+	{
+		glDeleteProgram(program);
+		std::cout << "SHADER RELOAD FAILED, KEEPING OLD PROGRAM FOR " << m_VertexPath << " + " << m_FragmentPath << std::endl;
+		return false;
+	}
+
+	Delete();
+	m_Id = program;
+	std::cout << "RELOADED SHADER " << m_VertexPath << " + " << m_FragmentPath << std::endl;
+	return true;
 }
+#endif
@@ -4,24 +4,79 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "ShaderPreprocessor.h"
+#include "ShaderSource.h"
+#ifdef SHADER_HOT_RELOAD
+#include <filesystem>
+#endif
 
 class ShaderProgram
 {
 public:
 	unsigned int m_Id;
+	//Combined hash of both sources and the variant defines, used as the key in ShaderLibrary.
+	//Stays the same across hot reloads.
+	uint64_t m_Key;
 public:
 	ShaderProgram(const char* vertexShaderFilePath, const char* fragmentShaderFilePath);
+	//Builds the variant selected by defines, which are injected after the #version line of both shaders
+	ShaderProgram(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines = ShaderDefines());
+	//Builds from precompiled SPIR-V, specialized with constants. These programs are never hot reloaded.
+	ShaderProgram(const SpirvSource& vertexShader, const SpirvSource& fragmentShader, const SpecializationConstants& constants);
+	static uint64_t MakeKey(const ShaderSource& vertexShader, const ShaderSource& fragmentShader, const ShaderDefines& defines);
+	static uint64_t MakeKey(const SpirvSource& vertexShader, const SpirvSource& fragmentShader, const SpecializationConstants& constants);
 	~ShaderProgram();
+	//Building is asynchronous: the constructor only submits the shaders to the driver.
+	//The first Activate waits for the build to finish and reports any errors.
 	void Activate() const;
+	//Polls GL_COMPLETION_STATUS_KHR without blocking. Always true without parallel shader compile.
+	bool IsReady() const;
+	//Waits for the build to finish and reports errors. Called by Activate.
+	void Resolve() const;
 	void SetVector4f(const char* name, const glm::vec4& value) const;
 	void Set1i(const char* name, int value) const;
+	//By explicit location, since SPIR-V programs can not look uniforms up by name
+	void Set1f(int location, float value) const;
+	void Set1i(int location, int value) const;
+	void Set2i(int location, int x, int y) const;
+	void Set2f(int location, float x, float y) const;
+	void Set4f(int location, float x, float y, float z, float w) const;
+	void SetMatrix4f(int location, const glm::mat4& value) const;
+#ifdef SHADER_HOT_RELOAD
+	//Rebuilds the program from disk when either shader or one of its includes was saved since the last build.
+	//A program that fails to compile is thrown away and the old one keeps running.
+	bool ReloadIfChanged();
+#endif
 private:
-	void CompileErrors(unsigned int shader, const char* type) const;
+	unsigned int Submit(std::string_view vertexShaderCode, std::string_view fragmentShaderCode, unsigned int& vertexShader, unsigned int& fragmentShader) const;
+	unsigned int SubmitSpirv(const SpirvSource& vertexShaderModule, const SpirvSource& fragmentShaderModule, const SpecializationConstants& constants, unsigned int& vertexShader, unsigned int& fragmentShader) const;
+	unsigned int Link(unsigned int vertexShader, unsigned int fragmentShader) const;
+	bool Finish(unsigned int program, unsigned int vertexShader, unsigned int fragmentShader) const;
+	bool CompileErrors(unsigned int shader, const char* type) const;
 	std::string GetFileContents(const char* path) const;
 	void Delete() const;
 
+	//Shader objects of a build that has not been resolved yet; needed for the error logs
+	mutable bool m_Pending;
+	mutable unsigned int m_PendingVertexShader;
+	mutable unsigned int m_PendingFragmentShader;
+#ifdef SHADER_HOT_RELOAD
+	void Watch(const std::vector<std::string>& files);
+	std::filesystem::file_time_type LastWriteTime(const std::string& path) const;
+
+	std::string m_VertexPath;
+	std::string m_FragmentPath;
+	std::string m_Defines;
+	//Both shaders and everything they include
+	std::vector<std::pair<std::string, std::filesystem::file_time_type>> m_WatchedFiles;
+#endif
+
 };
 #endif
\ No newline at end of file
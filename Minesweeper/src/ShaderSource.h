@@ -0,0 +1,106 @@
+#ifndef SHADER_SOURCE_CLASS
+#define SHADER_SOURCE_CLASS
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+//Hot reload watches the files under res/shaders and rebuilds programs when they change.
+//Release builds only ever use the sources embedded by tools/EmbedShaders.ps1.
+#ifdef _DEBUG
+#define SHADER_HOT_RELOAD 1
+#endif
+
+//FNV-1a, evaluated at compile time for embedded shaders
+constexpr uint64_t HashShaderSource(const std::string_view code, uint64_t hash = 14695981039346656037ull)
+{
+	for (const char c : code)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+//Order matters so that (vertex, fragment) and (fragment, vertex) give different keys
+constexpr uint64_t CombineShaderHashes(const uint64_t first, const uint64_t second)
+{
+	return first ^ (second + 0x9E3779B97F4A7C15ull + (first << 6) + (first >> 2));
+}
+
+struct ShaderSource
+{
+	//Path relative to the working directory, e.g. res/shaders/tile/vertex.shader
+	std::string_view name;
+	std::string_view code;
+	uint64_t hash;
+};
+
+constexpr ShaderSource MakeShaderSource(const std::string_view name, const std::string_view code)
+{
+	return ShaderSource{ name, code, HashShaderSource(code) };
+}
+
+//A SPIR-V module compiled offline by tools/EmbedShaders.ps1. wordCount is 0 when
+//glslangValidator was not available at build time; callers then use the GLSL source.
+struct SpirvSource
+{
+	std::string_view name;
+	const uint32_t* words;
+	size_t wordCount;
+	uint64_t hash;
+};
+
+constexpr SpirvSource MakeSpirvSource(const std::string_view name, const uint32_t* words, const size_t wordCount)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < wordCount; i++)
+	{
+		hash ^= words[i];
+		hash *= 1099511628211ull;
+	}
+	return SpirvSource{ name, words, wordCount, hash };
+}
+
+//The SPIR-V counterpart of ShaderDefines: values for layout(constant_id = N) constants
+class SpecializationConstants
+{
+private:
+	std::vector<unsigned int> m_Ids;
+	std::vector<unsigned int> m_Values;
+public:
+	SpecializationConstants& Set(const unsigned int id, const bool value)
+	{
+		return Set(id, static_cast<unsigned int>(value));
+	}
+
+	SpecializationConstants& Set(const unsigned int id, const unsigned int value)
+	{
+		m_Ids.push_back(id);
+		m_Values.push_back(value);
+		return *this;
+	}
+
+	SpecializationConstants& Set(const unsigned int id, const float value)
+	{
+		unsigned int bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return Set(id, bits);
+	}
+
+	const std::vector<unsigned int>& Ids() const { return m_Ids; }
+	const std::vector<unsigned int>& Values() const { return m_Values; }
+
+	uint64_t Hash() const
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < m_Ids.size(); i++)
+		{
+			hash = (hash ^ m_Ids[i]) * 1099511628211ull;
+			hash = (hash ^ m_Values[i]) * 1099511628211ull;
+		}
+		return hash;
+	}
+};
+#endif
@@ -0,0 +1,168 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cstddef>
+#include <glm/gtc/matrix_transform.hpp>
+#include "GLCounters.h"
+
+namespace
+{
+	//Location of the projection uniform in res/shaders/sprite/vertex.shader
+	const int PROJECTION_UNIFORM_LOCATION = 0;
+
+	std::vector<unsigned int> QuadIndices(const size_t quads)
+	{
+		std::vector<unsigned int> indices;
+		indices.reserve(quads * 6);
+		for (unsigned int i = 0; i < quads; i++)
+		{
+			const unsigned int first = i * 4;
+			indices.insert(indices.end(), { first, first + 1, first + 2, first + 1, first + 2, first + 3 });
+		}
+		return indices;
+	}
+}
+
+SpriteBatch::SpriteBatch(const ShaderProgram& defaultShader)
+	: m_DefaultShader(defaultShader),
+	  m_VBO(NULL, static_cast<unsigned int>(MAX_SPRITES * 4 * sizeof(Vertex)), GL_STREAM_DRAW),
+	  m_IBO(QuadIndices(MAX_SPRITES).data(), static_cast<unsigned int>(MAX_SPRITES * 6 * sizeof(unsigned int))),
+	  m_Projection(1.0f)
+{
+	m_Sprites.reserve(MAX_SPRITES);
+	m_Sorted.reserve(MAX_SPRITES);
+	m_Vertices.reserve(MAX_SPRITES * 4);
+
+	//VAO GENERATION
+	m_VAO.Bind();
+	m_IBO.Bind();
+	m_VAO.LinkAttrib(m_VBO, 0, 2, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, position));
+	m_VAO.LinkAttrib(m_VBO, 1, 2, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+	m_VAO.LinkAttrib(m_VBO, 2, 4, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, color));
+	m_VAO.Unbind();
+	m_IBO.Unbind();
+
+	//WHITE TEXTURE for untextured sprites
+	const unsigned char white[4] = { 255, 255, 255, 255 };
+	glGenTextures(1, &m_WhiteTexture);
+	glBindTexture(GL_TEXTURE_2D, m_WhiteTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+SpriteBatch::~SpriteBatch()
+{
+	glDeleteTextures(1, &m_WhiteTexture);
+}
+
+void SpriteBatch::Begin(const int width, const int height)
+{
+	m_Projection = glm::ortho(0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f);
+	m_Sprites.clear();
+	m_Stats = Stats();
+}
+
+void SpriteBatch::Draw(const float x, const float y, const float width, const float height, const glm::vec4& color, const int layer)
+{
+	Draw(x, y, width, height, m_WhiteTexture, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), color, layer, NULL);
+}
+
+void SpriteBatch::Draw(const float x, const float y, const float width, const float height, const unsigned int texture, const glm::vec4& texCoords,
+                       const glm::vec4& color, const int layer, const ShaderProgram* shader)
+{
+	//Anything past the buffer's capacity goes out early, still in order
+	if (m_Sprites.size() == MAX_SPRITES)
+		Flush();
+
+	Sprite sprite;
+	sprite.shader = shader ? shader : &m_DefaultShader;
+	sprite.texture = texture;
+	sprite.layer = layer;
+	sprite.order = static_cast<uint32_t>(m_Sprites.size());
+	sprite.rect = glm::vec4(x, y, x + width, y + height);
+	sprite.texCoords = texCoords;
+	sprite.color = color;
+	m_Sprites.push_back(sprite);
+}
+
+void SpriteBatch::End()
+{
+	Flush();
+}
+
+void SpriteBatch::Flush()
+{
+	if (m_Sprites.empty())
+		return;
+
+	//SORT indices rather than the sprites themselves
+	m_Sorted.clear();
+	for (uint32_t i = 0; i < m_Sprites.size(); i++)
+		m_Sorted.push_back(i);
+	std::sort(m_Sorted.begin(), m_Sorted.end(), [this](const uint32_t a, const uint32_t b)
+	{
+		const Sprite& first = m_Sprites[a];
+		const Sprite& second = m_Sprites[b];
+		if (first.layer != second.layer)
+			return first.layer < second.layer;
+		if (first.shader != second.shader)
+			return first.shader->m_Id < second.shader->m_Id;
+		if (first.texture != second.texture)
+			return first.texture < second.texture;
+		return first.order < second.order;
+	});
+
+	//VERTICES in sorted order, uploaded in one go into orphaned storage
+	m_Vertices.clear();
+	for (const uint32_t index : m_Sorted)
+	{
+		const Sprite& sprite = m_Sprites[index];
+		const glm::vec4& r = sprite.rect;
+		const glm::vec4& t = sprite.texCoords;
+		m_Vertices.push_back(Vertex{ glm::vec2(r.x, r.y), glm::vec2(t.x, t.y), sprite.color });
+		m_Vertices.push_back(Vertex{ glm::vec2(r.z, r.y), glm::vec2(t.z, t.y), sprite.color });
+		m_Vertices.push_back(Vertex{ glm::vec2(r.x, r.w), glm::vec2(t.x, t.w), sprite.color });
+		m_Vertices.push_back(Vertex{ glm::vec2(r.z, r.w), glm::vec2(t.z, t.w), sprite.color });
+	}
+	m_VBO.SetData(NULL, static_cast<unsigned int>(MAX_SPRITES * 4 * sizeof(Vertex)), GL_STREAM_DRAW);
+	m_VBO.SubData(0, static_cast<unsigned int>(m_Vertices.size() * sizeof(Vertex)), m_Vertices.data());
+	m_VBO.Unbind();
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glActiveTexture(GL_TEXTURE0);
+	m_VAO.Bind();
+
+	//One draw per run of the same shader and texture
+	const ShaderProgram* activeShader = NULL;
+	size_t runStart = 0;
+	for (size_t i = 1; i <= m_Sorted.size(); i++)
+	{
+		const Sprite& first = m_Sprites[m_Sorted[runStart]];
+		if (i < m_Sorted.size())
+		{
+			const Sprite& next = m_Sprites[m_Sorted[i]];
+			if (next.shader == first.shader && next.texture == first.texture)
+				continue;
+		}
+
+		if (first.shader != activeShader)
+		{
+			activeShader = first.shader;
+			activeShader->Activate();
+			activeShader->SetMatrix4f(PROJECTION_UNIFORM_LOCATION, m_Projection);
+		}
+		glBindTexture(GL_TEXTURE_2D, first.texture);
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>((i - runStart) * 6), GL_UNSIGNED_INT, (void*)(runStart * 6 * sizeof(unsigned int)));
+		m_Stats.drawCalls++;
+		GLCounters::Current().drawCalls++;
+		runStart = i;
+	}
+
+	m_VAO.Unbind();
+	glDisable(GL_BLEND);
+
+	m_Stats.sprites += static_cast<unsigned int>(m_Sprites.size());
+	m_Sprites.clear();
+}
@@ -0,0 +1,74 @@
+#ifndef SPRITE_BATCH_CLASS
+#define SPRITE_BATCH_CLASS
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "IndexBufferObject.h"
+#include "ShaderProgram.h"
+#include "VertexArrayObject.h"
+#include "VertexBufferObject.h"
+
+//Immediate mode quads for the HUD and menus. Everything drawn between Begin and End goes into
+//one streaming vertex buffer; End sorts by layer, then shader, then texture, and issues one draw
+//per run of quads that share a shader and texture. All storage is reserved up front, so calling
+//it every frame does not allocate.
+class SpriteBatch
+{
+public:
+	static const size_t MAX_SPRITES = 4096;
+
+	struct Stats
+	{
+		unsigned int sprites = 0;
+		unsigned int drawCalls = 0;
+	};
+private:
+	struct Sprite
+	{
+		const ShaderProgram* shader;
+		unsigned int texture;
+		int layer;
+		//Submission order, which keeps overlapping sprites on the same layer in order
+		uint32_t order;
+		glm::vec4 rect;
+		glm::vec4 texCoords;
+		glm::vec4 color;
+	};
+
+	struct Vertex
+	{
+		glm::vec2 position;
+		glm::vec2 texCoord;
+		glm::vec4 color;
+	};
+
+	const ShaderProgram& m_DefaultShader;
+	unsigned int m_WhiteTexture;
+	VertexArrayObject m_VAO;
+	VertexBufferObject m_VBO;
+	IndexBufferObject m_IBO;
+
+	std::vector<Sprite> m_Sprites;
+	std::vector<uint32_t> m_Sorted;
+	std::vector<Vertex> m_Vertices;
+	glm::mat4 m_Projection;
+	Stats m_Stats;
+public:
+	//defaultShader is used by sprites that do not name one, normally res/shaders/sprite
+	explicit SpriteBatch(const ShaderProgram& defaultShader);
+	~SpriteBatch();
+	//Starts a frame of sprites in pixels, (0, 0) at the top left of a width x height viewport
+	void Begin(int width, int height);
+	//A colored rectangle
+	void Draw(float x, float y, float width, float height, const glm::vec4& color, int layer = 0);
+	//A textured rectangle; texCoords are (u0, v0, u1, v1). shader NULL means the default shader.
+	void Draw(float x, float y, float width, float height, unsigned int texture, const glm::vec4& texCoords,
+	          const glm::vec4& color = glm::vec4(1.0f), int layer = 0, const ShaderProgram* shader = NULL);
+	//Draws everything submitted since Begin
+	void End();
+	//Counts of the last frame
+	Stats GetStats() const { return m_Stats; }
+private:
+	void Flush();
+};
+#endif
@@ -0,0 +1,45 @@
+#ifndef SPSC_QUEUE_CLASS
+#define SPSC_QUEUE_CLASS
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+//Bounded lock-free queue for exactly one producer thread and one consumer thread.
+//Neither side ever blocks: TryPush fails when the queue is full and TryPop when it is empty.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+private:
+	//Head and tail live on their own cache lines so the two threads do not false share.
+	//Both only ever grow; the slot is the count modulo Capacity.
+	alignas(64) std::atomic<size_t> m_Head{ 0 };
+	alignas(64) std::atomic<size_t> m_Tail{ 0 };
+	alignas(64) std::array<T, Capacity> m_Items;
+public:
+	//Producer side
+	bool TryPush(T item)
+	{
+		const size_t tail = m_Tail.load(std::memory_order_relaxed);
+		if (tail - m_Head.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		m_Items[tail & (Capacity - 1)] = std::move(item);
+		m_Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Consumer side
+	bool TryPop(T& item)
+	{
+		const size_t head = m_Head.load(std::memory_order_relaxed);
+		if (head == m_Tail.load(std::memory_order_acquire))
+			return false;
+
+		item = std::move(m_Items[head & (Capacity - 1)]);
+		m_Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+};
+#endif
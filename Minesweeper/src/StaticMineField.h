@@ -0,0 +1,160 @@
+#ifndef STATIC_MINE_FIELD_CLASS
+#define STATIC_MINE_FIELD_CLASS
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "MineField.h"
+#include "Philox.h"
+#include "ThreadPool.h"
+
+//MineField for a size known at compile time: the bits and counts are plain arrays inside the
+//object, nothing is allocated, and every bound and neighbor offset is a constant. Boards fit in
+//one MineField chunk, so for the same seed it places exactly the mines MineField does.
+template <int COLUMNS, int ROWS>
+class StaticMineField
+{
+	static_assert(COLUMNS > 0 && ROWS > 0, "StaticMineField needs at least one cell");
+	static_assert(static_cast<size_t>(COLUMNS) * ROWS <= MineField::CHUNK_CELLS, "StaticMineField boards must fit in one MineField chunk");
+public:
+	static constexpr size_t CELLS = static_cast<size_t>(COLUMNS) * ROWS;
+	static constexpr size_t WORDS = (CELLS + 63) / 64;
+private:
+	std::array<uint64_t, WORDS> m_Words;
+	std::array<uint8_t, CELLS> m_Counts;
+	size_t m_Mines;
+	uint64_t m_Seed;
+public:
+	StaticMineField()
+		: m_Words(), m_Counts(), m_Mines(0), m_Seed(0)
+	{
+	}
+
+	//The size arguments only keep the interface the same as MineField's
+	void Clear(int = COLUMNS, int = ROWS)
+	{
+		m_Words.fill(0);
+		m_Counts.fill(0);
+		m_Mines = 0;
+	}
+
+	void Generate(int, int, const size_t mines, const uint64_t seed, const int safeColumn, const int safeRow, ThreadPool* = nullptr)
+	{
+		Clear();
+		m_Seed = seed;
+		size_t excluded[9];
+		const size_t excludedCount = MineField::SafeCells(COLUMNS, ROWS, safeColumn, safeRow, excluded);
+		m_Mines = std::min(mines, CELLS - excludedCount);
+
+		//Stream 1 is the one MineField gives its first chunk
+		Philox random(seed, 1);
+		MineField::Sample(m_Words.data(), 0, CELLS, m_Mines, excluded, excludedCount, random);
+
+		Count();
+	}
+
+	//See MineField::Place
+	void Place(int, int, const size_t mines, const uint64_t seed, const size_t* excluded, const size_t excludedCount, ThreadPool* = nullptr)
+	{
+		Clear();
+		m_Seed = seed;
+		m_Mines = std::min(mines, CELLS - excludedCount);
+		Philox random(seed, 1);
+		MineField::Sample(m_Words.data(), 0, CELLS, m_Mines, excluded, excludedCount, random);
+	}
+
+	//See MineField::Recount
+	template <typename Topology>
+	void Recount(ThreadPool* = nullptr)
+	{
+		const auto bitsAt = [this](const int64_t bit) { return MineField::BitsAt(m_Words.data(), WORDS, bit); };
+		for (int row = 0; row < ROWS; row++)
+		{
+			for (int column = 0; column < COLUMNS; column += 64)
+			{
+				uint64_t sum[4];
+				Topology::CountLanes(column, row, COLUMNS, ROWS, bitsAt, sum);
+				for (int lane = 0; lane < 64 && column + lane < COLUMNS; lane++)
+					m_Counts[static_cast<size_t>(row) * COLUMNS + column + lane] = static_cast<uint8_t>(
+						((sum[0] >> lane) & 1) | ((sum[1] >> lane) & 1) << 1 | ((sum[2] >> lane) & 1) << 2 | ((sum[3] >> lane) & 1) << 3);
+			}
+		}
+	}
+
+	bool IsMine(const int column, const int row) const
+	{
+		const size_t bit = static_cast<size_t>(row) * COLUMNS + column;
+		return (m_Words[bit >> 6] >> (bit & 63)) & 1;
+	}
+	int AdjacentMines(const int column, const int row) const { return m_Counts[static_cast<size_t>(row) * COLUMNS + column]; }
+
+	static constexpr int Columns() { return COLUMNS; }
+	static constexpr int Rows() { return ROWS; }
+	size_t Mines() const { return m_Mines; }
+	uint64_t Seed() const { return m_Seed; }
+	const std::array<uint64_t, WORDS>& Words() const { return m_Words; }
+private:
+	uint64_t Row(const int row) const
+	{
+		const size_t bit = static_cast<size_t>(row) * COLUMNS;
+		const size_t word = bit >> 6;
+		const unsigned int shift = bit & 63;
+		uint64_t bits = m_Words[word] >> shift;
+		if (shift != 0 && word + 1 < WORDS)
+			bits |= m_Words[word + 1] << (64 - shift);
+		return COLUMNS == 64 ? bits : bits & ((uint64_t(1) << (COLUMNS % 64)) - 1);
+	}
+
+	void Count()
+	{
+		if constexpr (COLUMNS <= 64)
+		{
+			//A whole row fits in a register: the eight neighbor masks of a row are shifts of the rows
+			//above, below and itself, summed bit-sliced into four planes for all its cells at once
+			const uint64_t mask = COLUMNS == 64 ? ~uint64_t(0) : (uint64_t(1) << COLUMNS) - 1;
+			uint64_t above = 0;
+			uint64_t current = Row(0);
+			for (int row = 0; row < ROWS; row++)
+			{
+				const uint64_t below = row + 1 < ROWS ? Row(row + 1) : 0;
+				const uint64_t neighbors[8] =
+				{
+					(above << 1) & mask, above, above >> 1,
+					(current << 1) & mask, current >> 1,
+					(below << 1) & mask, below, below >> 1
+				};
+				uint64_t sum[4] = {};
+				for (const uint64_t plane : neighbors)
+				{
+					uint64_t carry = plane;
+					for (int i = 0; i < 4; i++)
+					{
+						const uint64_t next = sum[i] & carry;
+						sum[i] ^= carry;
+						carry = next;
+					}
+				}
+				for (int column = 0; column < COLUMNS; column++)
+					m_Counts[static_cast<size_t>(row) * COLUMNS + column] = static_cast<uint8_t>(
+						((sum[0] >> column) & 1) | ((sum[1] >> column) & 1) << 1 | ((sum[2] >> column) & 1) << 2 | ((sum[3] >> column) & 1) << 3);
+				above = current;
+				current = below;
+			}
+		}
+		else
+		{
+			for (int row = 0; row < ROWS; row++)
+			{
+				for (int column = 0; column < COLUMNS; column++)
+				{
+					int count = 0;
+					for (int y = row - 1; y <= row + 1; y++)
+						for (int x = column - 1; x <= column + 1; x++)
+							count += x >= 0 && x < COLUMNS && y >= 0 && y < ROWS && (x != column || y != row) && IsMine(x, y);
+					m_Counts[static_cast<size_t>(row) * COLUMNS + column] = static_cast<uint8_t>(count);
+				}
+			}
+		}
+	}
+};
+#endif
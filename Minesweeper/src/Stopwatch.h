@@ -0,0 +1,62 @@
+#ifndef STOPWATCH_CLASS
+#define STOPWATCH_CLASS
+#include <algorithm>
+
+//The in-game timer. Started and stopped with game time taken from the input event that
+//caused it (GameClock::TimeAt), so the result does not depend on tick or frame rate.
+class Stopwatch
+{
+private:
+	double m_Start;
+	double m_Stop;
+	bool m_Running;
+	bool m_Started;
+public:
+	Stopwatch()
+		: m_Start(0.0), m_Stop(0.0), m_Running(false), m_Started(false)
+	{
+	}
+
+	void Start(const double time)
+	{
+		m_Start = time;
+		m_Running = true;
+		m_Started = true;
+	}
+
+	void Stop(const double time)
+	{
+		if (!m_Running)
+			return;
+		m_Stop = time;
+		m_Running = false;
+	}
+
+	//Carries on from where Stop left it, as if it had never stopped, e.g. when an undo takes back
+	//the move that ended the game
+	void Resume(const double time)
+	{
+		if (m_Running || !m_Started)
+			return;
+		m_Start += time - m_Stop;
+		m_Running = true;
+	}
+
+	void Reset()
+	{
+		*this = Stopwatch();
+	}
+
+	bool IsRunning() const { return m_Running; }
+	bool HasStarted() const { return m_Started; }
+
+	//Seconds shown at game time `time`. Never negative: the start is the event's exact time, which
+	//can be up to a tick later than the tick time it is read at.
+	double Elapsed(const double time) const
+	{
+		if (!m_Started)
+			return 0.0;
+		return std::max(0.0, (m_Running ? time : m_Stop) - m_Start);
+	}
+};
+#endif
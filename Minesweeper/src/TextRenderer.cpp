@@ -0,0 +1,61 @@
+#include "TextRenderer.h"
+
+TextRenderer::TextRenderer(const ShaderProgram& shader)
+	: m_Shader(shader)
+{
+	glGenTextures(1, &m_Texture);
+	glBindTexture(GL_TEXTURE_2D, m_Texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_Atlas.Width(), m_Atlas.Height(), 0, GL_RED, GL_UNSIGNED_BYTE, m_Atlas.Pixels().data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+TextRenderer::~TextRenderer()
+{
+	glDeleteTextures(1, &m_Texture);
+}
+
+void TextRenderer::Draw(SpriteBatch& batch, const std::string_view text, const float x, const float y, const float height,
+                        const glm::vec4& color, const int layer) const
+{
+	//Pixels per atlas texel
+	const float scale = height / (FontAtlas::GRID_HEIGHT * FontAtlas::TEXELS_PER_UNIT);
+	const float advance = FontAtlas::Advance() * FontAtlas::TEXELS_PER_UNIT * scale;
+	const float padding = FontAtlas::PADDING * scale;
+
+	float penX = x;
+	for (const char character : text)
+	{
+		if (character != ' ')
+		{
+			const FontAtlas::Glyph& glyph = m_Atlas.GetGlyph(character);
+			batch.Draw(penX - padding, y - padding, FontAtlas::CELL_WIDTH * scale, FontAtlas::CELL_HEIGHT * scale,
+			           m_Texture, glm::vec4(glyph.u0, glyph.v0, glyph.u1, glyph.v1), color, layer, &m_Shader);
+		}
+		penX += advance;
+	}
+}
+
+float TextRenderer::Measure(const std::string_view text, const float height) const
+{
+	if (text.empty())
+		return 0.0f;
+	const float scale = height / (FontAtlas::GRID_HEIGHT * FontAtlas::TEXELS_PER_UNIT);
+	//The last character has no gap after it
+	return (text.size() * FontAtlas::Advance() - 1.0f) * FontAtlas::TEXELS_PER_UNIT * scale;
+}
+
+void TextRenderer::DrawRect(SpriteBatch& batch, const float x, const float y, const float width, const float height,
+                            const glm::vec4& color, const int layer) const
+{
+	//Every corner samples the middle of the solid cell, well away from its neighbours
+	const FontAtlas::Glyph& solid = m_Atlas.GetGlyph(FontAtlas::SOLID);
+	const float u = (solid.u0 + solid.u1) / 2.0f;
+	const float v = (solid.v0 + solid.v1) / 2.0f;
+	batch.Draw(x, y, width, height, m_Texture, glm::vec4(u, v, u, v), color, layer, &m_Shader);
+}
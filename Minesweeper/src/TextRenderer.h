@@ -0,0 +1,30 @@
+#ifndef TEXT_RENDERER_CLASS
+#define TEXT_RENDERER_CLASS
+#include <string_view>
+#include <glm/glm.hpp>
+#include "FontAtlas.h"
+#include "ShaderProgram.h"
+#include "SpriteBatch.h"
+
+//Text as SpriteBatch quads over one FontAtlas texture. Every string drawn on the same layer
+//shares the shader and texture, so all text in a frame ends up in a single draw call.
+class TextRenderer
+{
+private:
+	FontAtlas m_Atlas;
+	unsigned int m_Texture;
+	const ShaderProgram& m_Shader;
+public:
+	static const int LAYER = 3;
+
+	//shader is res/shaders/sprite/vertex.shader with res/shaders/text/fragment.shader
+	explicit TextRenderer(const ShaderProgram& shader);
+	~TextRenderer();
+	//Draws text with its top left corner at (x, y); height is the cap height in pixels
+	void Draw(SpriteBatch& batch, std::string_view text, float x, float y, float height, const glm::vec4& color, int layer = LAYER) const;
+	//Width in pixels text would take up at height
+	float Measure(std::string_view text, float height) const;
+	//A solid rectangle that batches with the text, for panels and graphs drawn along with it
+	void DrawRect(SpriteBatch& batch, float x, float y, float width, float height, const glm::vec4& color, int layer = LAYER) const;
+};
+#endif
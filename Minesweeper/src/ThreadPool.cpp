@@ -0,0 +1,79 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(const unsigned int workers)
+	: m_Job(nullptr), m_Count(0), m_Next(0), m_Busy(0), m_Generation(0), m_Stopping(false)
+{
+	for (unsigned int i = 0; i < workers; i++)
+		m_Workers.emplace_back(&ThreadPool::Work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_Wake.notify_all();
+	for (std::thread& worker : m_Workers)
+		worker.join();
+}
+
+unsigned int ThreadPool::DefaultWorkers()
+{
+	const unsigned int hardware = std::thread::hardware_concurrency();
+	return hardware > 1 ? hardware - 1 : 0;
+}
+
+void ThreadPool::RunJob(const std::function<void(size_t)>& job, const size_t count)
+{
+	for (size_t i = m_Next.fetch_add(1, std::memory_order_relaxed); i < count; i = m_Next.fetch_add(1, std::memory_order_relaxed))
+		job(i);
+}
+
+void ThreadPool::ParallelFor(const size_t count, const std::function<void(size_t)>& job)
+{
+	if (count == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job = &job;
+		m_Count = count;
+		m_Next.store(0, std::memory_order_relaxed);
+		m_Busy = m_Workers.size();
+		m_Generation++;
+	}
+	m_Wake.notify_all();
+
+	RunJob(job, count);
+
+	//Workers still hold a pointer to job until they report back
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_Done.wait(lock, [this]() { return m_Busy == 0; });
+	m_Job = nullptr;
+}
+
+void ThreadPool::Work()
+{
+	unsigned long long seen = 0;
+	while (true)
+	{
+		const std::function<void(size_t)>* job;
+		size_t count;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Wake.wait(lock, [&]() { return m_Stopping || m_Generation != seen; });
+			if (m_Stopping)
+				return;
+			seen = m_Generation;
+			job = m_Job;
+			count = m_Count;
+		}
+
+		RunJob(*job, count);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (--m_Busy == 0)
+			m_Done.notify_one();
+	}
+}
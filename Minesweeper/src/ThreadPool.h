@@ -0,0 +1,44 @@
+#ifndef THREAD_POOL_CLASS
+#define THREAD_POOL_CLASS
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Fixed set of worker threads for data-parallel loops. The calling thread joins in, so a pool
+//with 0 workers simply runs everything inline.
+class ThreadPool
+{
+private:
+	std::vector<std::thread> m_Workers;
+	std::mutex m_Mutex;
+	std::condition_variable m_Wake;
+	std::condition_variable m_Done;
+	//The loop being run; m_Generation changes whenever a new one starts
+	const std::function<void(size_t)>* m_Job;
+	size_t m_Count;
+	std::atomic<size_t> m_Next;
+	size_t m_Busy;
+	unsigned long long m_Generation;
+	bool m_Stopping;
+public:
+	//Defaults to one worker less than the hardware has, the caller being the last one
+	explicit ThreadPool(unsigned int workers = DefaultWorkers());
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	//Calls job(i) for every i in [0, count) across the pool and returns when all are done.
+	//Indices are handed out in no particular order, so job must not depend on one.
+	void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+	unsigned int Threads() const { return static_cast<unsigned int>(m_Workers.size()) + 1; }
+
+	static unsigned int DefaultWorkers();
+private:
+	void Work();
+	void RunJob(const std::function<void(size_t)>& job, size_t count);
+};
+#endif
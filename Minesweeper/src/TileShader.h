@@ -0,0 +1,59 @@
+#ifndef TILE_SHADER_CLASS
+#define TILE_SHADER_CLASS
+#include "ShaderLibrary.h"
+#include "ShaderPreprocessor.h"
+#include "ShaderSource.h"
+#include "generated/EmbeddedShaders.h"
+
+//Feature flags for res/shaders/tile. Each combination is its own specialized program,
+//so nothing in the shaders branches on a uniform to pick a feature.
+namespace TileShader
+{
+	enum Feature : unsigned int
+	{
+		FLAT = 0,
+		TEXTURED = 1 << 0,
+		ANIMATED = 1 << 1,
+		HOVER_HIGHLIGHT = 1 << 2
+	};
+
+	//Must match the constant_id values in res/shaders/tile/common.glsl
+	enum SpecializationId : unsigned int
+	{
+		SPECIALIZATION_TEXTURED = 0,
+		SPECIALIZATION_ANIMATED = 1,
+		SPECIALIZATION_HOVER_HIGHLIGHT = 2,
+		SPECIALIZATION_TILE_SCALE = 3
+	};
+
+	inline ShaderDefines Defines(const unsigned int features, const float tileScale = 1.0f)
+	{
+		ShaderDefines defines;
+		if (features & TEXTURED)
+			defines.Define("TEXTURED");
+		if (features & ANIMATED)
+			defines.Define("ANIMATED");
+		if (features & HOVER_HIGHLIGHT)
+			defines.Define("HOVER_HIGHLIGHT");
+		defines.Define("TILE_SCALE", tileScale);
+		return defines;
+	}
+
+	inline SpecializationConstants Specialization(const unsigned int features, const float tileScale = 1.0f)
+	{
+		SpecializationConstants constants;
+		constants.Set(SPECIALIZATION_TEXTURED, (features & TEXTURED) != 0);
+		constants.Set(SPECIALIZATION_ANIMATED, (features & ANIMATED) != 0);
+		constants.Set(SPECIALIZATION_HOVER_HIGHLIGHT, (features & HOVER_HIGHLIGHT) != 0);
+		constants.Set(SPECIALIZATION_TILE_SCALE, tileScale);
+		return constants;
+	}
+
+	//SPIR-V specialization when available, the GLSL variant otherwise
+	inline const ShaderProgram& Get(ShaderLibrary& library, const unsigned int features, const float tileScale = 1.0f)
+	{
+		return library.GetSpecialized(EmbeddedShaders::TileVertexSpirv, EmbeddedShaders::TileFragmentSpirv, Specialization(features, tileScale),
+		                              EmbeddedShaders::TileVertex, EmbeddedShaders::TileFragment, Defines(features, tileScale));
+	}
+}
+#endif
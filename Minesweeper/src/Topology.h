@@ -0,0 +1,321 @@
+#ifndef TOPOLOGY_CLASS
+#define TOPOLOGY_CLASS
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+//Grid topologies as compile-time policies. A policy is a table of neighbor offsets plus how its cells
+//are laid out in world units; the board engine, the mine fields and picking are templated on it, so
+//every loop over neighbors is a loop over a constant table and the square grid compiles to what a
+//hand-written 3x3 loop would.
+struct GridTopology
+{
+	//Sent to the renderer with a new board
+	enum Kind
+	{
+		SQUARE,
+		HEX,
+		TRIANGLE,
+		TORUS,
+		KIND_COUNT
+	};
+
+	//Cells an offset applies to: hex rows alternate between two offset sets, and triangles between
+	//pointing up ((column + row) even) and down
+	enum Condition : uint8_t
+	{
+		ALWAYS,
+		EVEN_ROW,
+		ODD_ROW,
+		UP,
+		DOWN
+	};
+
+	struct Offset
+	{
+		int dx;
+		int dy;
+		Condition condition;
+	};
+
+	//World layout of cell (column, row): its bounding box starts at
+	//(column * columnStep + (row odd ? oddRowShift : 0), row * rowStep) and is 1 wide and cellHeight high
+	struct Layout
+	{
+		double columnStep;
+		double rowStep;
+		double oddRowShift;
+		double cellHeight;
+		//Every other cell is mirrored vertically, for triangles
+		bool alternate;
+	};
+
+	static constexpr bool Applies(const Condition condition, const int column, const int row)
+	{
+		switch (condition)
+		{
+		case EVEN_ROW:
+			return (row & 1) == 0;
+		case ODD_ROW:
+			return (row & 1) != 0;
+		case UP:
+			return ((column + row) & 1) == 0;
+		case DOWN:
+			return ((column + row) & 1) != 0;
+		default:
+			return true;
+		}
+	}
+};
+
+//Neighbor iteration, bit-sliced counting and picking shared by every policy, generated from its table
+template <typename Topology>
+struct TopologyKernels
+{
+	//Calls visit(x, y) for each neighbor of (column, row) on the board
+	template <typename Visit>
+	static void ForEachNeighbor(const int column, const int row, const int columns, const int rows, const Visit& visit)
+	{
+		for (const GridTopology::Offset& offset : Topology::OFFSETS)
+		{
+			if (!GridTopology::Applies(offset.condition, column, row))
+				continue;
+			int x = column + offset.dx;
+			int y = row + offset.dy;
+			if constexpr (Topology::WRAPS)
+			{
+				x = (x % columns + columns) % columns;
+				y = (y % rows + rows) % rows;
+			}
+			else if (x < 0 || x >= columns || y < 0 || y >= rows)
+			{
+				continue;
+			}
+			visit(x, y);
+		}
+	}
+
+	//Neighbor counts of the up to 64 cells of row starting at firstColumn as four bit planes, lane i
+	//being column firstColumn + i. bitsAt(bit) returns the 64 mine bits of the row-major field from
+	//any bit index on.
+	template <typename BitsAt>
+	static void CountLanes(const int firstColumn, const int row, const int columns, const int rows, const BitsAt& bitsAt, uint64_t (&sum)[4])
+	{
+		sum[0] = sum[1] = sum[2] = sum[3] = 0;
+		//Lanes whose cell points up, for the UP and DOWN offsets
+		const uint64_t up = ((firstColumn + row) & 1) == 0 ? 0x5555555555555555ull : 0xAAAAAAAAAAAAAAAAull;
+		for (const GridTopology::Offset& offset : Topology::OFFSETS)
+		{
+			if ((offset.condition == GridTopology::EVEN_ROW || offset.condition == GridTopology::ODD_ROW)
+			    && !GridTopology::Applies(offset.condition, 0, row))
+				continue;
+
+			int y = row + offset.dy;
+			if constexpr (Topology::WRAPS)
+				y = (y % rows + rows) % rows;
+			else if (y < 0 || y >= rows)
+				continue;
+
+			uint64_t plane = Segment(bitsAt, y, firstColumn + offset.dx, columns);
+			if (offset.condition == GridTopology::UP)
+				plane &= up;
+			else if (offset.condition == GridTopology::DOWN)
+				plane &= ~up;
+
+			//Ripple carry into the planes; 12 neighbors still fit in four
+			uint64_t carry = plane;
+			for (int i = 0; i < 4 && carry; i++)
+			{
+				const uint64_t next = sum[i] & carry;
+				sum[i] ^= carry;
+				carry = next;
+			}
+		}
+	}
+
+	//World position of the center of a cell's bounding box
+	static void Center(const int column, const int row, double& x, double& y)
+	{
+		x = column * Topology::LAYOUT.columnStep + ((row & 1) ? Topology::LAYOUT.oddRowShift : 0.0) + 0.5;
+		y = row * Topology::LAYOUT.rowStep + Topology::LAYOUT.cellHeight * 0.5;
+	}
+
+	//World size of a whole board, for fitting the camera
+	static void Extent(const int columns, const int rows, double& width, double& height)
+	{
+		width = (columns - 1) * Topology::LAYOUT.columnStep + (rows > 1 ? Topology::LAYOUT.oddRowShift : 0.0) + 1.0;
+		height = (rows - 1) * Topology::LAYOUT.rowStep + Topology::LAYOUT.cellHeight;
+	}
+
+private:
+	//64 bits of row y from column on. Columns off the board are zero, or wrap around on a torus.
+	template <typename BitsAt>
+	static uint64_t Segment(const BitsAt& bitsAt, const int y, const int column, const int columns)
+	{
+		const int64_t rowStart = static_cast<int64_t>(y) * columns;
+		if constexpr (Topology::WRAPS)
+		{
+			uint64_t bits = 0;
+			int x = (column % columns + columns) % columns;
+			for (int filled = 0; filled < 64; x = 0)
+			{
+				const int take = std::min(64 - filled, columns - x);
+				const uint64_t piece = bitsAt(rowStart + x) & (take == 64 ? ~uint64_t(0) : (uint64_t(1) << take) - 1);
+				bits |= piece << filled;
+				filled += take;
+			}
+			return bits;
+		}
+		else
+		{
+			if (column <= -64 || column >= columns)
+				return 0;
+			uint64_t bits = bitsAt(rowStart + column);
+			if (column < 0)
+				bits &= ~uint64_t(0) << -column;
+			if (columns - column < 64)
+				bits &= (uint64_t(1) << (columns - column)) - 1;
+			return bits;
+		}
+	}
+};
+
+//The classic grid: 8 neighbors, cells are unit squares
+struct SquareTopology : TopologyKernels<SquareTopology>
+{
+	static constexpr GridTopology::Kind KIND = GridTopology::SQUARE;
+	static constexpr bool WRAPS = false;
+	static constexpr int MAX_NEIGHBORS = 8;
+	static constexpr GridTopology::Offset OFFSETS[] =
+	{
+		{ -1, -1, GridTopology::ALWAYS }, { 0, -1, GridTopology::ALWAYS }, { 1, -1, GridTopology::ALWAYS },
+		{ -1,  0, GridTopology::ALWAYS },                                  { 1,  0, GridTopology::ALWAYS },
+		{ -1,  1, GridTopology::ALWAYS }, { 0,  1, GridTopology::ALWAYS }, { 1,  1, GridTopology::ALWAYS }
+	};
+	static constexpr GridTopology::Layout LAYOUT = { 1.0, 1.0, 0.0, 1.0, false };
+
+	static bool CellAt(const double x, const double y, const int columns, const int rows, int& column, int& row)
+	{
+		column = static_cast<int>(std::floor(x));
+		row = static_cast<int>(std::floor(y));
+		return x >= 0.0 && y >= 0.0 && column < columns && row < rows;
+	}
+};
+
+//The square grid with opposite edges joined, so every cell has 8 neighbors. Drawn as one copy of the board.
+struct TorusTopology : TopologyKernels<TorusTopology>
+{
+	static constexpr GridTopology::Kind KIND = GridTopology::TORUS;
+	static constexpr bool WRAPS = true;
+	static constexpr int MAX_NEIGHBORS = 8;
+	static constexpr GridTopology::Offset OFFSETS[] =
+	{
+		{ -1, -1, GridTopology::ALWAYS }, { 0, -1, GridTopology::ALWAYS }, { 1, -1, GridTopology::ALWAYS },
+		{ -1,  0, GridTopology::ALWAYS },                                  { 1,  0, GridTopology::ALWAYS },
+		{ -1,  1, GridTopology::ALWAYS }, { 0,  1, GridTopology::ALWAYS }, { 1,  1, GridTopology::ALWAYS }
+	};
+	static constexpr GridTopology::Layout LAYOUT = { 1.0, 1.0, 0.0, 1.0, false };
+
+	static bool CellAt(const double x, const double y, const int columns, const int rows, int& column, int& row)
+	{
+		return SquareTopology::CellAt(x, y, columns, rows, column, row);
+	}
+};
+
+//Pointy-top hexagons one unit wide with odd rows shifted half a cell right: 6 neighbors
+struct HexTopology : TopologyKernels<HexTopology>
+{
+	static constexpr GridTopology::Kind KIND = GridTopology::HEX;
+	static constexpr bool WRAPS = false;
+	static constexpr int MAX_NEIGHBORS = 6;
+	static constexpr GridTopology::Offset OFFSETS[] =
+	{
+		{ -1, 0, GridTopology::ALWAYS }, { 1, 0, GridTopology::ALWAYS },
+		{ 0, -1, GridTopology::ALWAYS }, { 0, 1, GridTopology::ALWAYS },
+		{ -1, -1, GridTopology::EVEN_ROW }, { -1, 1, GridTopology::EVEN_ROW },
+		{ 1, -1, GridTopology::ODD_ROW }, { 1, 1, GridTopology::ODD_ROW }
+	};
+	//Rows are 3/4 of a hexagon's height apart, which is 2 / sqrt(3) times its width
+	static constexpr GridTopology::Layout LAYOUT = { 1.0, 0.86602540378443865, 0.5, 1.1547005383792515, false };
+
+	//Hexagons are the Voronoi cells of their centers, so the nearest center wins
+	static bool CellAt(const double x, const double y, const int columns, const int rows, int& column, int& row)
+	{
+		const int guessRow = static_cast<int>(std::floor(y / LAYOUT.rowStep));
+		double best = 1e300;
+		for (int r = guessRow - 1; r <= guessRow + 1; r++)
+		{
+			const int guessColumn = static_cast<int>(std::floor(x - ((r & 1) ? LAYOUT.oddRowShift : 0.0)));
+			for (int c = guessColumn - 1; c <= guessColumn + 1; c++)
+			{
+				double centerX, centerY;
+				Center(c, r, centerX, centerY);
+				const double distance = (x - centerX) * (x - centerX) + (y - centerY) * (y - centerY);
+				if (distance < best)
+				{
+					best = distance;
+					column = c;
+					row = r;
+				}
+			}
+		}
+		return column >= 0 && column < columns && row >= 0 && row < rows;
+	}
+};
+
+//Equilateral triangles one unit wide alternating up and down along a row, half a unit apart.
+//Neighbors are every triangle sharing a corner: 12, of which 3 share an edge.
+struct TriangleTopology : TopologyKernels<TriangleTopology>
+{
+	static constexpr GridTopology::Kind KIND = GridTopology::TRIANGLE;
+	static constexpr bool WRAPS = false;
+	static constexpr int MAX_NEIGHBORS = 12;
+	static constexpr GridTopology::Offset OFFSETS[] =
+	{
+		{ -2, 0, GridTopology::ALWAYS }, { -1, 0, GridTopology::ALWAYS }, { 1, 0, GridTopology::ALWAYS }, { 2, 0, GridTopology::ALWAYS },
+		{ -1, -1, GridTopology::ALWAYS }, { 0, -1, GridTopology::ALWAYS }, { 1, -1, GridTopology::ALWAYS },
+		{ -1, 1, GridTopology::ALWAYS }, { 0, 1, GridTopology::ALWAYS }, { 1, 1, GridTopology::ALWAYS },
+		//The wide side of a triangle touches five cells of the next row
+		{ -2, -1, GridTopology::DOWN }, { 2, -1, GridTopology::DOWN },
+		{ -2, 1, GridTopology::UP }, { 2, 1, GridTopology::UP }
+	};
+	static constexpr GridTopology::Layout LAYOUT = { 0.5, 0.86602540378443865, 0.0, 0.86602540378443865, true };
+
+	static bool CellAt(const double x, const double y, const int columns, const int rows, int& column, int& row)
+	{
+		row = static_cast<int>(std::floor(y / LAYOUT.rowStep));
+		//0 at the top of the row, 1 at the bottom
+		const double down = y / LAYOUT.rowStep - row;
+		//An up triangle at c spans x in [c / 2 + (1 - down) / 2, c / 2 + (1 + down) / 2]; the down
+		//triangles fill the gaps, so the cell is the one whose span holds x
+		column = static_cast<int>(std::floor(2.0 * x));
+		for (int c = column - 1; c <= column; c++)
+		{
+			const bool up = ((c + row) & 1) == 0;
+			const double offset = up ? down : 1.0 - down;
+			if (x >= c * 0.5 + (1.0 - offset) * 0.5 && x < c * 0.5 + (1.0 + offset) * 0.5)
+			{
+				column = c;
+				break;
+			}
+		}
+		return y >= 0.0 && column >= 0 && column < columns && row < rows;
+	}
+};
+
+//Layout of a topology known only at run time, for the renderer
+inline const GridTopology::Layout& LayoutOf(const GridTopology::Kind kind)
+{
+	switch (kind)
+	{
+	case GridTopology::HEX:
+		return HexTopology::LAYOUT;
+	case GridTopology::TRIANGLE:
+		return TriangleTopology::LAYOUT;
+	case GridTopology::TORUS:
+		return TorusTopology::LAYOUT;
+	default:
+		return SquareTopology::LAYOUT;
+	}
+}
+#endif
@@ -33,3 +33,10 @@ void VertexArrayObject::LinkAttrib(const VertexBufferObject& VBO, const unsigned
 	glEnableVertexAttribArray(index);
 	VBO.Unbind();
 }
+
+void VertexArrayObject::LinkInstanceAttrib(const VertexBufferObject& VBO, const unsigned index, const unsigned numElements, const GLenum type,
+                                           const unsigned stride, const void* offset) const
+{
+	LinkAttrib(VBO, index, numElements, type, stride, offset);
+	glVertexAttribDivisor(index, 1);
+}
@@ -14,5 +14,7 @@ public:
 	void Bind() const;
 	void Unbind() const;
 	void LinkAttrib(const VertexBufferObject& VBO, const unsigned int index, const unsigned int numElements, GLenum type, const unsigned int stride, const void* offset) const;
+	//Like LinkAttrib, but the attribute advances once per instance instead of once per vertex
+	void LinkInstanceAttrib(const VertexBufferObject& VBO, const unsigned int index, const unsigned int numElements, GLenum type, const unsigned int stride, const void* offset) const;
 };
 #endif
@@ -1,10 +1,11 @@
 #include "VertexBufferObject.h"
+#include "GLCounters.h"
 
-VertexBufferObject::VertexBufferObject(const void* data, unsigned int size)
+VertexBufferObject::VertexBufferObject(const void* data, unsigned int size, GLenum usage)
 {
 	glGenBuffers(1, &m_Id);
 	Bind();
-	glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, size, data, usage);
 }
 
 VertexBufferObject::~VertexBufferObject()
@@ -22,6 +23,21 @@ void VertexBufferObject::Unbind() const
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void VertexBufferObject::SetData(const void* data, unsigned int size, GLenum usage) const
+{
+	Bind();
+	glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+	if (data)
+		GLCounters::Current().uploadBytes += size;
+}
+
+void VertexBufferObject::SubData(unsigned int offset, unsigned int size, const void* data) const
+{
+	Bind();
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	GLCounters::Current().uploadBytes += size;
+}
+
 void VertexBufferObject::Delete() const
 {
 	glDeleteBuffers(1, &m_Id);
@@ -7,10 +7,14 @@ class VertexBufferObject
 public:
 	unsigned int m_Id;
 public:
-	VertexBufferObject(const void* data, unsigned int size);
+	VertexBufferObject(const void* data, unsigned int size, GLenum usage = GL_STATIC_DRAW);
 	~VertexBufferObject();
 	void Bind() const;
 	void Unbind() const;
+	//Reallocates the whole buffer; data may be NULL
+	void SetData(const void* data, unsigned int size, GLenum usage) const;
+	//Overwrites part of the buffer in place
+	void SubData(unsigned int offset, unsigned int size, const void* data) const;
 private:
 	void Delete() const;
 };
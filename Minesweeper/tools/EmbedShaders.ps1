@@ -0,0 +1,155 @@
+# Turns every shader under res/shaders into a constexpr ShaderSource in src/generated/EmbeddedShaders.h
+# so the game never has to read shader code from disk. Runs as the project's pre-build step and only
+# rewrites the header when a shader actually changed, so it does not force a rebuild every time.
+#
+# Vertex and fragment shaders that mention GL_SPIRV are also compiled offline with glslangValidator
+# (from the Vulkan SDK) and embedded as <Identifier>Spirv. Without glslangValidator those modules are
+# left empty and ShaderLibrary falls back to compiling the GLSL at runtime.
+param(
+	[Parameter(Mandatory = $true)][string]$ProjectDir,
+	[string]$OutFile = 'src\generated\EmbeddedShaders.h'
+)
+
+$ErrorActionPreference = 'Stop'
+
+$ProjectDir = (Resolve-Path $ProjectDir).Path.TrimEnd('\', '/')
+$shaderRoot = Join-Path $ProjectDir 'res\shaders'
+$outPath = Join-Path $ProjectDir $OutFile
+
+# MSVC refuses string literal pieces longer than 16K, so long shaders are split into adjacent literals
+$chunkLength = 4096
+
+$glslang = $null
+if ($env:VULKAN_SDK -and (Test-Path (Join-Path $env:VULKAN_SDK 'Bin\glslangValidator.exe')))
+{
+	$glslang = Join-Path $env:VULKAN_SDK 'Bin\glslangValidator.exe'
+}
+else
+{
+	$command = Get-Command glslangValidator -ErrorAction SilentlyContinue
+	if ($command)
+	{
+		$glslang = $command.Source
+	}
+}
+if (-not $glslang)
+{
+	Write-Host 'EmbedShaders: glslangValidator not found, shaders will only be embedded as GLSL'
+}
+$spirvDir = Join-Path (Split-Path -Parent $outPath) 'spirv'
+
+# res/shaders/tile/fragment.shader -> TileFragment
+function Get-Identifier([string]$relativePath)
+{
+	$identifier = ''
+	foreach ($part in ($relativePath -split '[\\/]'))
+	{
+		foreach ($word in ([System.IO.Path]::GetFileNameWithoutExtension($part) -split '[^A-Za-z0-9]+'))
+		{
+			if ($word.Length -gt 0)
+			{
+				$identifier += $word.Substring(0, 1).ToUpper() + $word.Substring(1)
+			}
+		}
+	}
+	return $identifier
+}
+
+$builder = New-Object System.Text.StringBuilder
+[void]$builder.Append("// Generated by tools/EmbedShaders.ps1 from res/shaders. Do not edit, rebuild instead.`n")
+[void]$builder.Append("#ifndef EMBEDDED_SHADERS`n#define EMBEDDED_SHADERS`n#include `"../ShaderSource.h`"`n`n")
+[void]$builder.Append("namespace EmbeddedShaders`n{`n")
+
+$identifiers = @()
+$files = Get-ChildItem -Path $shaderRoot -Recurse -File -Include '*.shader', '*.glsl' | Sort-Object FullName
+# Includes are not tracked per module, so any shader change rebuilds every SPIR-V module
+$newestShader = ($files | Measure-Object -Property LastWriteTimeUtc -Maximum).Maximum
+foreach ($file in $files)
+{
+	$relativeToShaders = $file.FullName.Substring($shaderRoot.Length + 1)
+	$identifier = Get-Identifier $relativeToShaders
+	if ($identifiers -contains $identifier)
+	{
+		throw "Two shaders map to the identifier $identifier ($relativeToShaders)"
+	}
+	$identifiers += $identifier
+
+	# ReadAllText strips the BOM; GLSL compilers choke on it
+	$code = [System.IO.File]::ReadAllText($file.FullName) -replace "`r`n", "`n"
+	if ($code.Contains(')SHADER"'))
+	{
+		throw "$relativeToShaders contains the raw string delimiter )SHADER`""
+	}
+
+	$name = 'res/shaders/' + ($relativeToShaders -replace '\\', '/')
+	[void]$builder.Append("`tinline constexpr ShaderSource $identifier = MakeShaderSource(`"$name`",`n")
+	for ($i = 0; $i -lt $code.Length; $i += $chunkLength)
+	{
+		$piece = $code.Substring($i, [Math]::Min($chunkLength, $code.Length - $i))
+		[void]$builder.Append("R`"SHADER($piece)SHADER`"`n")
+	}
+	if ($code.Length -eq 0)
+	{
+		[void]$builder.Append("`"`"`n")
+	}
+	[void]$builder.Append("`t);`n`n")
+
+	if (-not $code.Contains('GL_SPIRV'))
+	{
+		continue
+	}
+
+	$stage = $null
+	if ($file.BaseName -like 'vertex*') { $stage = 'vert' }
+	elseif ($file.BaseName -like 'fragment*') { $stage = 'frag' }
+	else { continue }
+
+	$words = New-Object System.Collections.Generic.List[string]
+	if ($glslang)
+	{
+		$spirvPath = Join-Path $spirvDir "$identifier.spv"
+		if (-not (Test-Path $spirvPath) -or (Get-Item $spirvPath).LastWriteTimeUtc -lt $newestShader)
+		{
+			New-Item -ItemType Directory -Force -Path $spirvDir | Out-Null
+			& $glslang -G -S $stage -o $spirvPath $file.FullName
+			if ($LASTEXITCODE -ne 0)
+			{
+				throw "glslangValidator failed on $relativeToShaders"
+			}
+		}
+
+		$bytes = [System.IO.File]::ReadAllBytes($spirvPath)
+		for ($i = 0; $i -lt $bytes.Length; $i += 4)
+		{
+			$words.Add('0x{0:X8}' -f [BitConverter]::ToUInt32($bytes, $i))
+		}
+	}
+
+	if ($words.Count -eq 0)
+	{
+		[void]$builder.Append("`tinline constexpr SpirvSource ${identifier}Spirv = MakeSpirvSource(`"$name`", nullptr, 0);`n`n")
+		continue
+	}
+
+	[void]$builder.Append("`tinline constexpr uint32_t ${identifier}SpirvWords[] =`n`t{`n")
+	for ($i = 0; $i -lt $words.Count; $i += 8)
+	{
+		$line = $words.GetRange($i, [Math]::Min(8, $words.Count - $i)) -join ', '
+		[void]$builder.Append("`t`t$line,`n")
+	}
+	[void]$builder.Append("`t};`n")
+	[void]$builder.Append("`tinline constexpr SpirvSource ${identifier}Spirv = MakeSpirvSource(`"$name`", ${identifier}SpirvWords, $($words.Count));`n`n")
+}
+
+[void]$builder.Append("`tinline constexpr ShaderSource All[] = { " + ($identifiers -join ', ') + " };`n")
+[void]$builder.Append("}`n#endif`n")
+
+$text = $builder.ToString()
+if ((Test-Path $outPath) -and ([System.IO.File]::ReadAllText($outPath) -eq $text))
+{
+	exit 0
+}
+
+New-Item -ItemType Directory -Force -Path (Split-Path -Parent $outPath) | Out-Null
+[System.IO.File]::WriteAllText($outPath, $text, (New-Object System.Text.UTF8Encoding $false))
+Write-Host "EmbedShaders: wrote $($identifiers.Count) shaders to $OutFile"